@@ -0,0 +1,508 @@
+#include "include/AirQualityDataManagerColumnar.hpp"
+#include "include/AirQualityCSVLoader.hpp"
+#include "include/PostingLists.hpp"
+#include "FilterKernels.hpp"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <omp.h>
+
+namespace {
+
+// Run a filter kernel over every block whose zone may hold a match
+template <typename T, typename MayContain>
+std::vector<RowId> selectInBlocks(const ZoneMaps &zoneMaps, const std::vector<T> &column,
+                                  T low, T high, MayContain mayContain) {
+    std::vector<size_t> candidates;
+    size_t candidateRows = 0;
+    
+    for (size_t block = 0; block < zoneMaps.getBlockCount(); block++) {
+        if (mayContain(zoneMaps.getZone(block))) {
+            std::pair<RowId, RowId> range = zoneMaps.getBlockRows(block);
+            candidates.push_back(block);
+            candidateRows += range.second - range.first;
+        }
+    }
+    
+    // Size for the worst case once, then trim to what the kernels selected
+    std::vector<RowId> rows(candidateRows);
+    size_t selected = 0;
+    
+    for (size_t block : candidates) {
+        std::pair<RowId, RowId> range = zoneMaps.getBlockRows(block);
+        selected += FilterKernels::selectRange(column.data() + range.first, range.second - range.first,
+                                               low, high, range.first, rows.data() + selected);
+    }
+    rows.resize(selected);
+    
+    return rows;
+}
+
+}
+
+// Append one reading to every column and index
+void AirQualityDataManagerColumnar::appendReading(const AirQualityReading &reading) {
+    RowId row = static_cast<RowId>(airQualityIndexes.size());
+    
+    latitudes.push_back(reading.getLatitude());
+    longitudes.push_back(reading.getLongitude());
+    values.push_back(reading.getValue());
+    rawConcentrations.push_back(reading.getRawConcentration());
+    timestamps.push_back(reading.getTimestamp());
+    airQualityIndexes.push_back(reading.getAirQualityIndex());
+    categories.push_back(reading.getCategory());
+    
+    datetimes.push_back(reading.getDatetimeCode());
+    pollutantTypes.push_back(reading.getPollutantTypeCode());
+    units.push_back(reading.getUnitCode());
+    siteNames.push_back(reading.getSiteNameCode());
+    agencyNames.push_back(reading.getAgencyNameCode());
+    siteIds.push_back(reading.getSiteIdCode());
+    fullSiteIds.push_back(reading.getFullSiteIdCode());
+    
+    rowsByDate[datetimes.back()].push_back(row);
+    rowsByPollutant[pollutantTypes.back()].push_back(row);
+}
+
+// Move shards into columns sized once by a prefix sum, then index the new
+// rows in parallel; no thread ever waits on another's merge
+void AirQualityDataManagerColumnar::appendShards(std::vector<std::vector<AirQualityReading>> &shards) {
+    std::vector<size_t> offsets(shards.size() + 1);
+    offsets[0] = airQualityIndexes.size();
+    for (size_t i = 0; i < shards.size(); i++) {
+        offsets[i + 1] = offsets[i] + shards[i].size();
+    }
+    
+    size_t rowCount = offsets.back();
+    latitudes.resize(rowCount);
+    longitudes.resize(rowCount);
+    values.resize(rowCount);
+    rawConcentrations.resize(rowCount);
+    timestamps.resize(rowCount);
+    airQualityIndexes.resize(rowCount);
+    categories.resize(rowCount);
+    
+    datetimes.resize(rowCount);
+    pollutantTypes.resize(rowCount);
+    units.resize(rowCount);
+    siteNames.resize(rowCount);
+    agencyNames.resize(rowCount);
+    siteIds.resize(rowCount);
+    fullSiteIds.resize(rowCount);
+    
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < shards.size(); i++) {
+        size_t row = offsets[i];
+        for (const AirQualityReading &reading : shards[i]) {
+            latitudes[row] = reading.getLatitude();
+            longitudes[row] = reading.getLongitude();
+            values[row] = reading.getValue();
+            rawConcentrations[row] = reading.getRawConcentration();
+            timestamps[row] = reading.getTimestamp();
+            airQualityIndexes[row] = reading.getAirQualityIndex();
+            categories[row] = reading.getCategory();
+            
+            datetimes[row] = reading.getDatetimeCode();
+            pollutantTypes[row] = reading.getPollutantTypeCode();
+            units[row] = reading.getUnitCode();
+            siteNames[row] = reading.getSiteNameCode();
+            agencyNames[row] = reading.getAgencyNameCode();
+            siteIds[row] = reading.getSiteIdCode();
+            fullSiteIds[row] = reading.getFullSiteIdCode();
+            row++;
+        }
+        std::vector<AirQualityReading>().swap(shards[i]);
+    }
+    
+    RowId first = static_cast<RowId>(offsets.front());
+    RowId last = static_cast<RowId>(rowCount);
+    appendPostingLists(rowsByDate, first, last, [this](RowId row) {
+        return datetimes[row];
+    });
+    appendPostingLists(rowsByPollutant, first, last, [this](RowId row) {
+        return pollutantTypes[row];
+    });
+    updateIndexes();
+}
+
+// Bring the time and AQI indexes and the zone maps up to date with rows added since the last call
+void AirQualityDataManagerColumnar::updateIndexes() {
+    std::vector<std::pair<std::int64_t, RowId>> entries;
+    entries.reserve(timestamps.size() - timeIndexedRows);
+    
+    for (size_t row = timeIndexedRows; row < timestamps.size(); row++) {
+        if (timestamps[row] != AirQualityReading::NO_TIMESTAMP) {
+            entries.emplace_back(timestamps[row], static_cast<RowId>(row));
+        }
+    }
+    
+    timeIndex.append(std::move(entries));
+    timeIndexedRows = timestamps.size();
+    
+    // Only the new rows are counting-sorted, then merged into the buckets
+    RowId firstNew = static_cast<RowId>(aqiIndex.size());
+    aqiIndex.append(firstNew, std::vector<int>(airQualityIndexes.begin() + firstNew, airQualityIndexes.end()));
+    
+    zoneMaps.update(timestamps.size(), [this](ZoneMaps::Zone &zone, RowId row) {
+        zone.include(airQualityIndexes[row], values[row], timestamps[row],
+                     latitudes[row], longitudes[row], categories[row], pollutantTypes[row]);
+    });
+}
+
+// Rebuild a reading object from the columns
+AirQualityReading AirQualityDataManagerColumnar::getReadingAt(size_t row) const {
+    return AirQualityReading(latitudes[row], longitudes[row], datetimes[row],
+                             pollutantTypes[row], values[row], units[row],
+                             rawConcentrations[row], airQualityIndexes[row],
+                             categories[row], siteNames[row], agencyNames[row],
+                             siteIds[row], fullSiteIds[row], timestamps[row]);
+}
+
+// Look up the row positions for a pollutant type
+const std::vector<RowId> &AirQualityDataManagerColumnar::getRowsByPollutant(const std::string &pollutantType) const {
+    static const std::vector<RowId> empty;
+    auto it = rowsByPollutant.find(StringPool::global().find(pollutantType));
+    return it != rowsByPollutant.end() ? it->second : empty;
+}
+
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsAt(const std::vector<RowId> &rows) const {
+    std::vector<AirQualityReading> result;
+    result.reserve(rows.size());
+    
+    for (RowId row : rows) {
+        result.push_back(getReadingAt(row));
+    }
+    
+    return result;
+}
+
+// Load data from a single CSV file
+void AirQualityDataManagerColumnar::loadFromCSV(const std::string &filename) {
+    AirQualityCSVLoader::loadFromCSV(filename, [this](const AirQualityReading &reading) {
+        appendReading(reading);
+    }, readMode);
+    updateIndexes();
+}
+
+// Load all CSV files from a date folder
+void AirQualityDataManagerColumnar::loadFromDateFolder(const std::string &dateFolderPath) {
+    AirQualityCSVLoader::loadFromDateFolder(dateFolderPath, [this](const AirQualityReading &reading) {
+        appendReading(reading);
+    }, readMode);
+    updateIndexes();
+}
+
+// Load all date folders from root directory
+void AirQualityDataManagerColumnar::loadFromDirectory(const std::string &rootPath) {
+    try {
+        for (const auto &entry : fs::directory_iterator(rootPath)) {
+            if (entry.is_directory()) {
+                std::cout << "Loading folder: " << entry.path().filename() << std::endl;
+                loadFromDateFolder(entry.path().string());
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading root directory " << rootPath 
+                  << ": " << e.what() << std::endl;
+    }
+}
+
+// Clear all data
+void AirQualityDataManagerColumnar::clear() {
+    latitudes.clear();
+    longitudes.clear();
+    values.clear();
+    rawConcentrations.clear();
+    timestamps.clear();
+    airQualityIndexes.clear();
+    categories.clear();
+    
+    datetimes.clear();
+    pollutantTypes.clear();
+    units.clear();
+    siteNames.clear();
+    agencyNames.clear();
+    siteIds.clear();
+    fullSiteIds.clear();
+    
+    rowsByDate.clear();
+    rowsByPollutant.clear();
+    timeIndex.clear();
+    timeIndexedRows = 0;
+    aqiIndex.clear();
+    zoneMaps.clear();
+}
+
+// Get all readings (materialized from the columns)
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getAllReadings() const {
+    std::vector<AirQualityReading> result;
+    result.reserve(airQualityIndexes.size());
+    
+    for (size_t row = 0; row < airQualityIndexes.size(); row++) {
+        result.push_back(getReadingAt(row));
+    }
+    
+    return result;
+}
+
+// Get count of readings
+int AirQualityDataManagerColumnar::getReadingCount() const {
+    return airQualityIndexes.size();
+}
+
+// Get readings by date (uses index - fast!)
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsByDate(const std::string &date) const {
+    auto it = rowsByDate.find(StringPool::global().find(date));
+    if (it != rowsByDate.end()) {
+        return getReadingsAt(it->second);
+    }
+    return std::vector<AirQualityReading>();  // Empty vector if not found
+}
+
+// Get readings by pollutant type (uses index - fast!)
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsByPollutant(const std::string &pollutantType) const {
+    return getReadingsAt(getRowsByPollutant(pollutantType));
+}
+
+// Get readings with start <= timestamp < end from the time index
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsByTimeRange(std::int64_t start, std::int64_t end) const {
+    std::pair<size_t, size_t> range = timeIndex.find(start, end);
+    const std::vector<RowId> &rows = timeIndex.getRowIds();
+    
+    std::vector<AirQualityReading> result;
+    result.reserve(range.second - range.first);
+    
+    for (size_t pos = range.first; pos < range.second; pos++) {
+        result.push_back(getReadingAt(rows[pos]));
+    }
+    
+    return result;
+}
+
+const TimeIndex &AirQualityDataManagerColumnar::getTimeIndex() const {
+    return timeIndex;
+}
+
+// Get readings within an AQI range from the AQI index (grouped by AQI value)
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsByAQIRange(int minAQI, int maxAQI) const {
+    std::pair<size_t, size_t> range = aqiIndex.find(minAQI, maxAQI);
+    const std::vector<RowId> &rows = aqiIndex.getRowIds();
+    
+    std::vector<AirQualityReading> result;
+    result.reserve(range.second - range.first);
+    
+    for (size_t pos = range.first; pos < range.second; pos++) {
+        result.push_back(getReadingAt(rows[pos]));
+    }
+    
+    return result;
+}
+
+// Select rows by AQI with the filter kernels, in row order
+std::vector<RowId> AirQualityDataManagerColumnar::selectRowsByAQIRange(int minAQI, int maxAQI) const {
+    return selectInBlocks(zoneMaps, airQualityIndexes, minAQI, maxAQI, [&](const ZoneMaps::Zone &zone) {
+        return zone.mayContainAQI(minAQI, maxAQI);
+    });
+}
+
+// Select rows by pollutant value with the filter kernels
+std::vector<RowId> AirQualityDataManagerColumnar::selectRowsByValueRange(double minValue, double maxValue) const {
+    return selectInBlocks(zoneMaps, values, minValue, maxValue, [&](const ZoneMaps::Zone &zone) {
+        return zone.mayContainValue(minValue, maxValue);
+    });
+}
+
+// Select rows by AQI category with the filter kernels
+std::vector<RowId> AirQualityDataManagerColumnar::selectRowsByCategory(int minCategory, int maxCategory) const {
+    return selectInBlocks(zoneMaps, categories, minCategory, maxCategory, [&](const ZoneMaps::Zone &zone) {
+        return zone.mayContainCategory(minCategory, maxCategory);
+    });
+}
+
+// Calculate average pollutant value (reads only the value column)
+double AirQualityDataManagerColumnar::getAveragePollutantValue(const std::string &pollutantType) const {
+    const std::vector<RowId> &rows = getRowsByPollutant(pollutantType);
+    if (rows.empty()) {
+        return 0.0;
+    }
+    
+    double sum = 0.0;
+    for (RowId row : rows) {
+        sum += values[row];
+    }
+    
+    return sum / rows.size();
+}
+
+// Get maximum pollutant value, skipping blocks whose max cannot beat the best so far
+double AirQualityDataManagerColumnar::getMaxPollutantValue(const std::string &pollutantType) const {
+    const std::vector<RowId> &rows = getRowsByPollutant(pollutantType);
+    
+    if (rows.empty()) {
+        return 0.0;
+    }
+    
+    double maxValue = std::numeric_limits<double>::lowest();
+    for (const auto &block : zoneMaps.getBlocksByMaxValue(StringPool::global().find(pollutantType))) {
+        // Blocks come in falling order of their max, so no later block can win
+        if (block.second <= maxValue) break;
+        
+        std::pair<size_t, size_t> slice = zoneMaps.findInBlock(rows, block.first);
+        for (size_t pos = slice.first; pos < slice.second; pos++) {
+            maxValue = std::max(maxValue, values[rows[pos]]);
+        }
+    }
+    
+    return maxValue;
+}
+
+// Count readings above an AQI threshold
+int AirQualityDataManagerColumnar::countReadingsAboveAQI(int threshold) const {
+    return static_cast<int>(aqiIndex.countAbove(threshold));
+}
+
+// Get all unique dates
+std::vector<std::string> AirQualityDataManagerColumnar::getAllDates() const {
+    std::vector<std::string> dates;
+    
+    for (const auto &pair : rowsByDate) {
+        dates.push_back(StringPool::global().get(pair.first));
+    }
+    
+    // Codes follow load order, so restore lexical order
+    std::sort(dates.begin(), dates.end());
+    return dates;
+}
+
+// Get all unique pollutant types
+std::vector<std::string> AirQualityDataManagerColumnar::getAllPollutantTypes() const {
+    std::vector<std::string> types;
+    
+    for (const auto &pair : rowsByPollutant) {
+        types.push_back(StringPool::global().get(pair.first));
+    }
+    
+    // Codes follow load order, so restore lexical order
+    std::sort(types.begin(), types.end());
+    return types;
+}
+
+// Parallel loading of directory
+void AirQualityDataManagerColumnar::loadFromDirectoryParallel(const std::string &rootPath, int numThreads) {
+    // Set number of threads
+    omp_set_num_threads(numThreads);
+    
+    // Get all folder paths first
+    std::vector<std::string> folderPaths;
+    try {
+        for (const auto &entry : fs::directory_iterator(rootPath)) {
+            if (entry.is_directory()) {
+                folderPaths.push_back(entry.path().string());
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading root directory " << rootPath 
+                  << ": " << e.what() << std::endl;
+        return;
+    }
+    
+    // One shard per folder, so threads never touch shared state while parsing
+    std::vector<std::vector<AirQualityReading>> shards(folderPaths.size());
+    
+    // Parallel loading
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < folderPaths.size(); i++) {
+        std::cout << "Thread " << omp_get_thread_num() 
+                  << " loading: " << fs::path(folderPaths[i]).filename() << std::endl;
+        
+        std::vector<AirQualityReading> &shard = shards[i];
+        AirQualityCSVLoader::loadFromDateFolder(folderPaths[i], [&shard](const AirQualityReading &reading) {
+            shard.push_back(reading);
+        }, readMode);
+    }
+    
+    // Shards are in folder order, so rows match a serial loadFromDirectory
+    appendShards(shards);
+}
+
+// Parse one file with all threads, each taking a newline-aligned byte range
+void AirQualityDataManagerColumnar::loadFromCSVParallel(const std::string &filename, int numThreads) {
+    auto shards = AirQualityCSVLoader::loadRangesFromCSVFiles({filename}, numThreads);
+    appendShards(shards);
+}
+
+// Parallel loading that splits files into byte ranges, so the thread count
+// is not capped by the number of date folders
+void AirQualityDataManagerColumnar::loadFromDirectoryByteRanges(const std::string &rootPath, int numThreads) {
+    std::vector<std::string> filenames = AirQualityCSVLoader::listCSVFiles(rootPath);
+    
+    auto shards = AirQualityCSVLoader::loadRangesFromCSVFiles(filenames, numThreads);
+    appendShards(shards);
+}
+
+// Parallel range query
+std::vector<AirQualityReading> AirQualityDataManagerColumnar::getReadingsByAQIRangeParallel(int minAQI, int maxAQI) const {
+    std::pair<size_t, size_t> range = aqiIndex.find(minAQI, maxAQI);
+    const std::vector<RowId> &rows = aqiIndex.getRowIds();
+    
+    // The slice size is known up front, so threads rebuild into disjoint slots
+    std::vector<AirQualityReading> result(range.second - range.first);
+    
+    #pragma omp parallel for
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = getReadingAt(rows[range.first + i]);
+    }
+    
+    return result;
+}
+
+// Parallel average calculation
+double AirQualityDataManagerColumnar::getAveragePollutantValueParallel(const std::string &pollutantType) const {
+    const std::vector<RowId> &rows = getRowsByPollutant(pollutantType);
+    if (rows.empty()) {
+        return 0.0;
+    }
+    
+    double sum = 0.0;
+    
+    #pragma omp parallel for reduction(+:sum)
+    for (size_t i = 0; i < rows.size(); i++) {
+        sum += values[rows[i]];
+    }
+    
+    return sum / rows.size();
+}
+
+// Parallel max calculation
+double AirQualityDataManagerColumnar::getMaxPollutantValueParallel(const std::string &pollutantType) const {
+    const std::vector<RowId> &rows = getRowsByPollutant(pollutantType);
+    
+    if (rows.empty()) {
+        return 0.0;
+    }
+    
+    const std::vector<std::pair<size_t, double>> &blocks =
+        zoneMaps.getBlocksByMaxValue(StringPool::global().find(pollutantType));
+    double maxValue = std::numeric_limits<double>::lowest();
+    
+    // Round-robin over the max-ordered blocks so every thread starts with a
+    // promising block; each then prunes against its own best (the private
+    // reduction copy), which only ever costs some extra blocks
+    #pragma omp parallel for schedule(static, 1) reduction(max:maxValue)
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (blocks[i].second <= maxValue) continue;
+        
+        std::pair<size_t, size_t> slice = zoneMaps.findInBlock(rows, blocks[i].first);
+        for (size_t pos = slice.first; pos < slice.second; pos++) {
+            maxValue = std::max(maxValue, values[rows[pos]]);
+        }
+    }
+    
+    return maxValue;
+}
+
+// Parallel count
+int AirQualityDataManagerColumnar::countReadingsAboveAQIParallel(int threshold) const {
+    // A bucket-offset difference; nothing left to split across threads
+    return static_cast<int>(aqiIndex.countAbove(threshold));
+}
@@ -0,0 +1,146 @@
+#include "include/AirQualityDataManagerSharded.hpp"
+#include "include/AirQualityCSVLoader.hpp"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+AirQualityDataManagerSharded::AirQualityDataManagerSharded()
+    : AirQualityDataManagerSharded(NumaTopology::nodes()) {}
+
+AirQualityDataManagerSharded::AirQualityDataManagerSharded(const std::vector<NumaTopology::Node> &nodes) {
+    for (const auto &node : nodes) {
+        shards.push_back(std::make_unique<Shard>());
+        shards.back()->node = node;
+    }
+}
+
+// Load every CSV file under a root of date folders, split across the shards
+void AirQualityDataManagerSharded::loadFromDirectory(const std::string &rootPath) {
+    loadFromCSVFiles(AirQualityCSVLoader::listCSVFiles(rootPath));
+}
+
+// Give each shard a contiguous run of files of about equal total size
+void AirQualityDataManagerSharded::loadFromCSVFiles(const std::vector<std::string> &filenames) {
+    std::vector<std::uintmax_t> sizes(filenames.size());
+    std::uintmax_t totalBytes = 0;
+    for (size_t i = 0; i < filenames.size(); i++) {
+        std::error_code error;
+        sizes[i] = fs::file_size(filenames[i], error);
+        if (error) sizes[i] = 0;
+        totalBytes += sizes[i];
+    }
+
+    std::vector<std::vector<std::string>> runs(shards.size());
+    std::uintmax_t assignedBytes = 0;
+    for (size_t i = 0; i < filenames.size(); i++) {
+        // The shard whose share of the bytes this file starts in
+        size_t shard = totalBytes ? static_cast<size_t>(assignedBytes * shards.size() / totalBytes) : 0;
+        runs[std::min(shard, shards.size() - 1)].push_back(filenames[i]);
+        assignedBytes += sizes[i];
+    }
+
+    // Parsed, stored and indexed by the shard's node only
+    runOnNodes([this, &runs](size_t shard) {
+        shards[shard]->data.loadFromCSVFiles(runs[shard], static_cast<int>(shards[shard]->node.cpus.size()));
+    });
+}
+
+void AirQualityDataManagerSharded::clear() {
+    for (auto &shard : shards) {
+        shard->data.clear();
+    }
+}
+
+int AirQualityDataManagerSharded::getReadingCount() const {
+    int count = 0;
+    for (const auto &shard : shards) {
+        count += shard->data.getReadingCount();
+    }
+    return count;
+}
+
+// Node-local sums weighted back together by row count
+double AirQualityDataManagerSharded::getAveragePollutantValue(const std::string &pollutantType) const {
+    std::vector<double> sums(shards.size(), 0.0);
+    std::vector<size_t> counts(shards.size(), 0);
+
+    runOnNodes([&](size_t shard) {
+        const AirQualityDataManager &data = shards[shard]->data;
+        counts[shard] = data.getRowIdsByPollutant(pollutantType).size();
+        sums[shard] = data.getAveragePollutantValueParallel(pollutantType) * counts[shard];
+    });
+
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t shard = 0; shard < shards.size(); shard++) {
+        sum += sums[shard];
+        count += counts[shard];
+    }
+    return count ? sum / count : 0.0;
+}
+
+double AirQualityDataManagerSharded::getMaxPollutantValue(const std::string &pollutantType) const {
+    std::vector<double> maxima(shards.size(), std::numeric_limits<double>::lowest());
+
+    runOnNodes([&](size_t shard) {
+        const AirQualityDataManager &data = shards[shard]->data;
+        if (!data.getRowIdsByPollutant(pollutantType).empty()) {
+            maxima[shard] = data.getMaxPollutantValueParallel(pollutantType);
+        }
+    });
+
+    double maxValue = *std::max_element(maxima.begin(), maxima.end());
+    return maxValue == std::numeric_limits<double>::lowest() ? 0.0 : maxValue;
+}
+
+// Answered by each shard's AQI index; too cheap to send to the nodes
+int AirQualityDataManagerSharded::countReadingsAboveAQI(int threshold) const {
+    int count = 0;
+    for (const auto &shard : shards) {
+        count += shard->data.countReadingsAboveAQI(threshold);
+    }
+    return count;
+}
+
+std::vector<AirQualityReading> AirQualityDataManagerSharded::getReadingsByAQIRange(int minAQI, int maxAQI) const {
+    std::vector<std::vector<AirQualityReading>> parts(shards.size());
+
+    runOnNodes([&](size_t shard) {
+        parts[shard] = shards[shard]->data.getReadingsByAQIRangeParallel(minAQI, maxAQI);
+    });
+
+    size_t total = 0;
+    for (const auto &part : parts) {
+        total += part.size();
+    }
+
+    std::vector<AirQualityReading> result;
+    result.reserve(total);
+    for (auto &part : parts) {
+        result.insert(result.end(), part.begin(), part.end());
+        std::vector<AirQualityReading>().swap(part);
+    }
+    return result;
+}
+
+std::vector<GroupBy::Row> AirQualityDataManagerSharded::groupBy(unsigned columns) const {
+    std::vector<std::vector<GroupBy::Row>> parts(shards.size());
+
+    runOnNodes([&](size_t shard) {
+        parts[shard] = shards[shard]->data.groupByParallel(columns);
+    });
+
+    std::map<GroupBy::Key, RollupCube::Stats> merged;
+    for (const auto &part : parts) {
+        for (const auto &row : part) {
+            merged[row.key].merge(row.stats);
+        }
+    }
+
+    std::vector<GroupBy::Row> result;
+    result.reserve(merged.size());
+    for (const auto &group : merged) {
+        result.push_back({group.first, group.second});
+    }
+    return result;
+}
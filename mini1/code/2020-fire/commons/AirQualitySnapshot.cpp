@@ -0,0 +1,397 @@
+#include "AirQualitySnapshot.hpp"
+#include "MappedFile.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+const char MAGIC[8] = {'A', 'Q', 'S', 'N', 'A', 'P', '\0', '\0'};
+
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t rowCount;
+    std::uint64_t dictionarySize;
+    std::uint64_t payloadBytes;
+    std::uint64_t checksum;
+};
+
+static_assert(sizeof(SnapshotHeader) % 8 == 0, "Header must keep the payload 8-byte aligned");
+
+// FNV-1a over 64-bit words (then the tail bytes): fast enough to check a
+// snapshot on every startup and catches truncated or corrupted files
+std::uint64_t checksum(std::string_view bytes) {
+    const std::uint64_t PRIME = 1099511628211ULL;
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    size_t pos = 0;
+    for (; pos + 8 <= bytes.size(); pos += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes.data() + pos, 8);
+        hash = (hash ^ word) * PRIME;
+    }
+    for (; pos < bytes.size(); pos++) {
+        hash = (hash ^ static_cast<unsigned char>(bytes[pos])) * PRIME;
+    }
+
+    return hash;
+}
+
+// Builds the payload as a sequence of 8-byte aligned sections
+class SnapshotWriter {
+private:
+    std::string bytes;
+
+public:
+    template <typename T>
+    void put(const T &value) {
+        bytes.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void putArray(const std::vector<T> &values) {
+        bytes.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+        align();
+    }
+
+    // Write one column of the readings, gathered through a getter
+    template <typename T, typename Getter>
+    void putColumn(const std::vector<AirQualityReading> &readings, Getter get) {
+        bytes.reserve(bytes.size() + readings.size() * sizeof(T) + 8);
+        for (const auto &reading : readings) {
+            put<T>(get(reading));
+        }
+        align();
+    }
+
+    void putBytes(std::string_view data) {
+        bytes.append(data.data(), data.size());
+    }
+
+    void align() {
+        bytes.resize((bytes.size() + 7) & ~static_cast<size_t>(7), '\0');
+    }
+
+    const std::string &payload() const { return bytes; }
+};
+
+// Reads sections back out of the mapped payload, failing on truncation
+class SnapshotReader {
+private:
+    std::string_view bytes;
+    size_t pos = 0;
+
+public:
+    explicit SnapshotReader(std::string_view bytes) : bytes(bytes) {}
+
+    template <typename T>
+    bool get(T &value) {
+        if (bytes.size() - pos < sizeof(T)) return false;
+        std::memcpy(&value, bytes.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    template <typename T>
+    bool getArray(std::vector<T> &values, size_t count) {
+        if ((bytes.size() - pos) / sizeof(T) < count) return false;
+        values.resize(count);
+        // An empty vector's data() may be null, which memcpy may not be given
+        if (count) {
+            std::memcpy(values.data(), bytes.data() + pos, count * sizeof(T));
+        }
+        pos += count * sizeof(T);
+        return align();
+    }
+
+    bool getBytes(std::string_view &data, size_t count) {
+        if (bytes.size() - pos < count) return false;
+        data = bytes.substr(pos, count);
+        pos += count;
+        return true;
+    }
+
+    bool align() {
+        pos = (pos + 7) & ~static_cast<size_t>(7);
+        return pos <= bytes.size();
+    }
+
+    bool atEnd() const { return pos == bytes.size(); }
+};
+
+// Gives every global code used by the snapshot a dense local code
+class Dictionary {
+private:
+    std::vector<StringPool::Code> localOf;
+
+public:
+    std::vector<StringPool::Code> globals;
+
+    StringPool::Code local(StringPool::Code global) {
+        if (global >= localOf.size()) {
+            localOf.resize(global + 1, StringPool::NOT_FOUND);
+        }
+        if (localOf[global] == StringPool::NOT_FOUND) {
+            localOf[global] = static_cast<StringPool::Code>(globals.size());
+            globals.push_back(global);
+        }
+        return localOf[global];
+    }
+};
+
+template <typename Getter>
+void putCodeColumn(SnapshotWriter &writer, const std::vector<AirQualityReading> &readings,
+                   Dictionary &dictionary, Getter get) {
+    writer.putColumn<StringPool::Code>(readings, [&](const AirQualityReading &reading) {
+        return dictionary.local(get(reading));
+    });
+}
+
+void putIndex(SnapshotWriter &writer, const PostingLists &index, Dictionary &dictionary) {
+    std::vector<StringPool::Code> keys;
+    std::vector<std::uint64_t> ends;
+    std::vector<RowId> rowIds;
+
+    for (const auto &pair : index) {
+        keys.push_back(dictionary.local(pair.first));
+        rowIds.insert(rowIds.end(), pair.second.begin(), pair.second.end());
+        ends.push_back(rowIds.size());
+    }
+
+    writer.put<std::uint64_t>(keys.size());
+    writer.putArray(keys);
+    writer.putArray(ends);
+    writer.putArray(rowIds);
+}
+
+bool getIndex(SnapshotReader &reader, PostingLists &index, const std::vector<StringPool::Code> &globals,
+              std::uint64_t rowCount) {
+    std::uint64_t keyCount;
+    std::vector<StringPool::Code> keys;
+    std::vector<std::uint64_t> ends;
+    std::vector<RowId> rowIds;
+
+    if (!reader.get(keyCount) || !reader.getArray(keys, keyCount) || !reader.getArray(ends, keyCount)) {
+        return false;
+    }
+    if (!reader.getArray(rowIds, keyCount > 0 ? ends.back() : 0)) {
+        return false;
+    }
+
+    std::uint64_t begin = 0;
+    for (size_t i = 0; i < keyCount; i++) {
+        if (keys[i] >= globals.size() || ends[i] < begin || ends[i] > rowIds.size()) {
+            return false;
+        }
+
+        std::vector<RowId> &rows = index[globals[keys[i]]];
+        rows.assign(rowIds.begin() + begin, rowIds.begin() + ends[i]);
+        for (RowId rowId : rows) {
+            if (rowId >= rowCount) return false;
+        }
+        begin = ends[i];
+    }
+
+    return true;
+}
+
+}
+
+bool AirQualitySnapshot::write(const std::string &path,
+                               const std::vector<AirQualityReading> &readings,
+                               const PostingLists &byDate,
+                               const PostingLists &byPollutant,
+                               const TimeIndex &byTime) {
+    SnapshotWriter columns;
+    Dictionary dictionary;
+
+    columns.putColumn<double>(readings, [](const AirQualityReading &r) { return r.getLatitude(); });
+    columns.putColumn<double>(readings, [](const AirQualityReading &r) { return r.getLongitude(); });
+    columns.putColumn<double>(readings, [](const AirQualityReading &r) { return r.getValue(); });
+    columns.putColumn<double>(readings, [](const AirQualityReading &r) { return r.getRawConcentration(); });
+    columns.putColumn<std::int64_t>(readings, [](const AirQualityReading &r) { return r.getTimestamp(); });
+    columns.putColumn<std::int32_t>(readings, [](const AirQualityReading &r) { return r.getAirQualityIndex(); });
+    columns.putColumn<std::int32_t>(readings, [](const AirQualityReading &r) { return r.getCategory(); });
+
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getDatetimeCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getPollutantTypeCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getUnitCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getSiteNameCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getAgencyNameCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getSiteIdCode(); });
+    putCodeColumn(columns, readings, dictionary, [](const AirQualityReading &r) { return r.getFullSiteIdCode(); });
+
+    putIndex(columns, byDate, dictionary);
+    putIndex(columns, byPollutant, dictionary);
+    columns.put<std::uint64_t>(byTime.size());
+    columns.putArray(byTime.getRowIds());
+
+    // The dictionary is complete only now, but it goes first in the file
+    SnapshotWriter payload;
+    StringPool &pool = StringPool::global();
+    std::vector<std::uint32_t> stringEnds;
+    std::uint32_t stringBytes = 0;
+
+    for (StringPool::Code global : dictionary.globals) {
+        stringBytes += static_cast<std::uint32_t>(pool.get(global).size());
+        stringEnds.push_back(stringBytes);
+    }
+    payload.putArray(stringEnds);
+    for (StringPool::Code global : dictionary.globals) {
+        payload.putBytes(pool.get(global));
+    }
+    payload.align();
+    payload.putBytes(columns.payload());
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.rowCount = readings.size();
+    header.dictionarySize = dictionary.globals.size();
+    header.payloadBytes = payload.payload().size();
+    header.checksum = checksum(payload.payload());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create snapshot " << path << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(payload.payload().data(), payload.payload().size());
+
+    if (!file) {
+        std::cerr << "Error: Could not write snapshot " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool AirQualitySnapshot::read(const std::string &path,
+                              std::vector<AirQualityReading> &readings,
+                              PostingLists &byDate,
+                              PostingLists &byPollutant,
+                              TimeIndex &byTime) {
+    readings.clear();
+    byDate.clear();
+    byPollutant.clear();
+    byTime.clear();
+
+    MappedFile file(path);
+    if (!file.isOpen()) {
+        std::cerr << "Error: Could not open snapshot " << path << std::endl;
+        return false;
+    }
+
+    std::string_view bytes = file.view();
+    SnapshotHeader header;
+
+    if (bytes.size() < sizeof(header)) {
+        std::cerr << "Error: Snapshot " << path << " is truncated" << std::endl;
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        std::cerr << "Error: " << path << " is not an air quality snapshot" << std::endl;
+        return false;
+    }
+    if (header.version != VERSION) {
+        std::cerr << "Error: Snapshot " << path << " has version " << header.version
+                  << " (expected " << VERSION << ")" << std::endl;
+        return false;
+    }
+
+    std::string_view payload = bytes.substr(sizeof(header));
+    if (payload.size() != header.payloadBytes || checksum(payload) != header.checksum) {
+        std::cerr << "Error: Snapshot " << path << " failed its checksum" << std::endl;
+        return false;
+    }
+
+    SnapshotReader reader(payload);
+    size_t rows = header.rowCount;
+
+    // Dictionary: intern every string and remember its global code
+    std::vector<std::uint32_t> stringEnds;
+    std::string_view strings;
+    bool ok = reader.getArray(stringEnds, header.dictionarySize) &&
+              reader.getBytes(strings, stringEnds.empty() ? 0 : stringEnds.back()) &&
+              reader.align();
+
+    std::vector<StringPool::Code> globals;
+    StringPool &pool = StringPool::global();
+    std::uint32_t begin = 0;
+
+    // Check every offset first, so a corrupt file interns nothing
+    for (size_t i = 0; ok && i < stringEnds.size(); i++) {
+        ok = stringEnds[i] >= begin && stringEnds[i] <= strings.size();
+        begin = stringEnds[i];
+    }
+
+    begin = 0;
+    for (size_t i = 0; ok && i < stringEnds.size(); i++) {
+        globals.push_back(pool.intern(strings.substr(begin, stringEnds[i] - begin)));
+        begin = stringEnds[i];
+    }
+
+    std::vector<double> latitudes, longitudes, values, rawConcentrations;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int32_t> airQualityIndexes, categories;
+    std::vector<StringPool::Code> codes[7];
+
+    ok = ok && reader.getArray(latitudes, rows) && reader.getArray(longitudes, rows) &&
+         reader.getArray(values, rows) && reader.getArray(rawConcentrations, rows) &&
+         reader.getArray(timestamps, rows) &&
+         reader.getArray(airQualityIndexes, rows) && reader.getArray(categories, rows);
+
+    for (auto &column : codes) {
+        ok = ok && reader.getArray(column, rows);
+        for (size_t row = 0; ok && row < rows; row++) {
+            ok = column[row] < globals.size();
+            column[row] = ok ? globals[column[row]] : 0;
+        }
+    }
+
+    ok = ok && getIndex(reader, byDate, globals, rows) && getIndex(reader, byPollutant, globals, rows);
+
+    // Time index: row ids in time order; timestamps come from the column
+    std::uint64_t timeRows = 0;
+    std::vector<RowId> timeRowIds;
+    std::vector<std::int64_t> timeStamps;
+
+    ok = ok && reader.get(timeRows) && timeRows <= rows && reader.getArray(timeRowIds, timeRows) &&
+         reader.atEnd();
+
+    for (size_t pos = 0; ok && pos < timeRowIds.size(); pos++) {
+        ok = timeRowIds[pos] < rows;
+        timeStamps.push_back(ok ? timestamps[timeRowIds[pos]] : 0);
+    }
+
+    if (!ok) {
+        std::cerr << "Error: Snapshot " << path << " is malformed" << std::endl;
+        byDate.clear();
+        byPollutant.clear();
+        return false;
+    }
+
+    if (!byTime.assign(std::move(timeStamps), std::move(timeRowIds))) {
+        std::cerr << "Error: Snapshot " << path << " has an unsorted time index" << std::endl;
+        byDate.clear();
+        byPollutant.clear();
+        return false;
+    }
+
+    readings.reserve(rows);
+    for (size_t row = 0; row < rows; row++) {
+        readings.emplace_back(latitudes[row], longitudes[row], codes[0][row], codes[1][row],
+                              values[row], codes[2][row], rawConcentrations[row],
+                              airQualityIndexes[row], categories[row], codes[3][row],
+                              codes[4][row], codes[5][row], codes[6][row], timestamps[row]);
+    }
+
+    return true;
+}
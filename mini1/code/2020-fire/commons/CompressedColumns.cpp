@@ -0,0 +1,237 @@
+#include "CompressedColumns.hpp"
+#include "AirQualityCSVLoader.hpp"
+#include "FilterKernels.hpp"
+#include <algorithm>
+#include <climits>
+#include <filesystem>
+#include <limits>
+#include <omp.h>
+
+void CompressedColumns::append(const AirQualityReading &reading) {
+    timestamps.append(reading.getTimestamp());
+    airQualityIndexes.append(reading.getAirQualityIndex());
+    categories.append(reading.getCategory());
+    pollutantTypes.append(reading.getPollutantTypeCode());
+    values.append(reading.getValue());
+    rawConcentrations.append(reading.getRawConcentration());
+}
+
+void CompressedColumns::append(const std::vector<AirQualityReading> &readings) {
+    for (const auto &reading : readings) {
+        append(reading);
+    }
+}
+
+int CompressedColumns::loadFromCSVFiles(const std::vector<std::string> &filenames, int numThreads) {
+    int loaded = 0;
+    std::vector<std::string> batch;
+    size_t batchBytes = 0;
+
+    auto flush = [&]() {
+        loaded += AirQualityCSVLoader::loadFromCSVFiles(batch, [this](const AirQualityReading &reading) {
+            append(reading);
+        }, numThreads);
+        batch.clear();
+        batchBytes = 0;
+    };
+
+    // Whole files only: a file larger than a batch is still split across threads
+    for (const auto &filename : filenames) {
+        std::error_code error;
+        std::uintmax_t bytes = std::filesystem::file_size(filename, error);
+
+        batch.push_back(filename);
+        batchBytes += error ? 0 : static_cast<size_t>(bytes);
+        if (batchBytes >= LOAD_BATCH_BYTES) flush();
+    }
+    if (!batch.empty()) flush();
+
+    shrinkToFit();
+    return loaded;
+}
+
+int CompressedColumns::loadFromDirectory(const std::string &rootPath, int numThreads) {
+    return loadFromCSVFiles(AirQualityCSVLoader::listCSVFiles(rootPath), numThreads);
+}
+
+void CompressedColumns::clear() {
+    timestamps.clear();
+    airQualityIndexes.clear();
+    categories.clear();
+    pollutantTypes.clear();
+    values.clear();
+    rawConcentrations.clear();
+}
+
+void CompressedColumns::shrinkToFit() {
+    timestamps.shrinkToFit();
+    airQualityIndexes.shrinkToFit();
+    categories.shrinkToFit();
+    pollutantTypes.shrinkToFit();
+    values.shrinkToFit();
+    rawConcentrations.shrinkToFit();
+}
+
+int CompressedColumns::getReadingCount() const {
+    return static_cast<int>(airQualityIndexes.size());
+}
+
+size_t CompressedColumns::memoryBytes() const {
+    return timestamps.memoryBytes() + airQualityIndexes.memoryBytes() + categories.memoryBytes() +
+           pollutantTypes.memoryBytes() + values.memoryBytes() + rawConcentrations.memoryBytes();
+}
+
+// What AirQualityDataManagerColumnar spends on the same six columns
+size_t CompressedColumns::plainBytes() const {
+    return airQualityIndexes.size() * (sizeof(std::int64_t) + 2 * sizeof(int) +
+                                       sizeof(StringPool::Code) + 2 * sizeof(double));
+}
+
+std::vector<RowId> CompressedColumns::selectRowsByAQIRange(int minAQI, int maxAQI) const {
+    std::vector<RowId> rows;
+    int block[BLOCK_ROWS];
+    RowId selected[BLOCK_ROWS];
+
+    for (size_t b = 0; b < airQualityIndexes.getBlockCount(); b++) {
+        std::pair<std::int64_t, std::int64_t> range = airQualityIndexes.getBlockRange(b);
+        if (range.second < minAQI || range.first > maxAQI) continue;
+
+        size_t count = airQualityIndexes.decodeBlock(b, block);
+        size_t matches = FilterKernels::selectRange(block, count, minAQI, maxAQI,
+                                                    static_cast<RowId>(b * BLOCK_ROWS), selected);
+        rows.insert(rows.end(), selected, selected + matches);
+    }
+    return rows;
+}
+
+std::vector<RowId> CompressedColumns::selectRowsByCategory(int minCategory, int maxCategory) const {
+    std::vector<RowId> rows;
+    int block[BLOCK_ROWS];
+    RowId selected[BLOCK_ROWS];
+
+    for (size_t b = 0; b < categories.getBlockCount(); b++) {
+        std::pair<std::int64_t, std::int64_t> range = categories.getBlockRange(b);
+        if (range.second < minCategory || range.first > maxCategory) continue;
+
+        size_t count = categories.decodeBlock(b, block);
+        size_t matches = FilterKernels::selectRange(block, count, minCategory, maxCategory,
+                                                    static_cast<RowId>(b * BLOCK_ROWS), selected);
+        rows.insert(rows.end(), selected, selected + matches);
+    }
+    return rows;
+}
+
+int CompressedColumns::countReadingsAboveAQI(int threshold) const {
+    if (threshold == INT_MAX) return 0;
+
+    size_t total = 0;
+    int block[BLOCK_ROWS];
+
+    for (size_t b = 0; b < airQualityIndexes.getBlockCount(); b++) {
+        std::pair<std::int64_t, std::int64_t> range = airQualityIndexes.getBlockRange(b);
+        if (range.second <= threshold) continue;
+
+        size_t count = airQualityIndexes.decodeBlock(b, block);
+        // A block entirely above the threshold needs no comparisons
+        total += range.first > threshold ? count
+                                         : FilterKernels::countRange(block, count, threshold + 1, INT_MAX);
+    }
+    return static_cast<int>(total);
+}
+
+int CompressedColumns::countReadingsByTimeRange(std::int64_t start, std::int64_t end) const {
+    size_t total = 0;
+    std::int64_t block[BLOCK_ROWS];
+
+    for (size_t b = 0; b < timestamps.getBlockCount(); b++) {
+        size_t count = timestamps.decodeBlock(b, block);
+        for (size_t i = 0; i < count; i++) {
+            total += block[i] >= start && block[i] < end;
+        }
+    }
+    return static_cast<int>(total);
+}
+
+// Decode the pollutant codes of a block, and its values only if the pollutant is there
+void CompressedColumns::scanPollutantBlock(size_t block, StringPool::Code pollutant,
+                                           double &sum, size_t &count, double &maxValue) const {
+    std::pair<std::int64_t, std::int64_t> range = pollutantTypes.getBlockRange(block);
+    if (pollutant < range.first || pollutant > range.second) return;
+
+    StringPool::Code codes[BLOCK_ROWS];
+    double blockValues[BLOCK_ROWS];
+
+    size_t rows = pollutantTypes.decodeBlock(block, codes);
+    values.decodeBlock(block, blockValues);
+
+    for (size_t i = 0; i < rows; i++) {
+        if (codes[i] == pollutant) {
+            sum += blockValues[i];
+            count++;
+            maxValue = std::max(maxValue, blockValues[i]);
+        }
+    }
+}
+
+double CompressedColumns::getAveragePollutantValue(const std::string &pollutantType) const {
+    StringPool::Code pollutant = StringPool::global().find(pollutantType);
+    if (pollutant == StringPool::NOT_FOUND) return 0.0;
+
+    double sum = 0.0;
+    size_t count = 0;
+    double maxValue = std::numeric_limits<double>::lowest();
+
+    for (size_t b = 0; b < pollutantTypes.getBlockCount(); b++) {
+        scanPollutantBlock(b, pollutant, sum, count, maxValue);
+    }
+    return count ? sum / count : 0.0;
+}
+
+double CompressedColumns::getMaxPollutantValue(const std::string &pollutantType) const {
+    StringPool::Code pollutant = StringPool::global().find(pollutantType);
+    if (pollutant == StringPool::NOT_FOUND) return 0.0;
+
+    double sum = 0.0;
+    size_t count = 0;
+    double maxValue = std::numeric_limits<double>::lowest();
+
+    for (size_t b = 0; b < pollutantTypes.getBlockCount(); b++) {
+        scanPollutantBlock(b, pollutant, sum, count, maxValue);
+    }
+    return count ? maxValue : 0.0;
+}
+
+double CompressedColumns::getAveragePollutantValueParallel(const std::string &pollutantType) const {
+    StringPool::Code pollutant = StringPool::global().find(pollutantType);
+    if (pollutant == StringPool::NOT_FOUND) return 0.0;
+
+    double sum = 0.0;
+    size_t count = 0;
+    long long blocks = static_cast<long long>(pollutantTypes.getBlockCount());
+
+    #pragma omp parallel for reduction(+:sum, count)
+    for (long long b = 0; b < blocks; b++) {
+        double maxValue = std::numeric_limits<double>::lowest();
+        scanPollutantBlock(static_cast<size_t>(b), pollutant, sum, count, maxValue);
+    }
+    return count ? sum / count : 0.0;
+}
+
+int CompressedColumns::countReadingsAboveAQIParallel(int threshold) const {
+    if (threshold == INT_MAX) return 0;
+
+    size_t total = 0;
+    long long blocks = static_cast<long long>(airQualityIndexes.getBlockCount());
+
+    #pragma omp parallel for reduction(+:total)
+    for (long long b = 0; b < blocks; b++) {
+        std::pair<std::int64_t, std::int64_t> range = airQualityIndexes.getBlockRange(static_cast<size_t>(b));
+        if (range.second <= threshold) continue;
+
+        int block[BLOCK_ROWS];
+        size_t count = airQualityIndexes.decodeBlock(static_cast<size_t>(b), block);
+        total += range.first > threshold ? count
+                                         : FilterKernels::countRange(block, count, threshold + 1, INT_MAX);
+    }
+    return static_cast<int>(total);
+}
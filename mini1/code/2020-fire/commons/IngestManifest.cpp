@@ -0,0 +1,32 @@
+#include "IngestManifest.hpp"
+
+IngestManifest::Status IngestManifest::check(const std::string &path, std::uint64_t size, std::int64_t modified) const {
+    const FileEntry *entry = find(path);
+    if (!entry) {
+        return Status::New;
+    }
+    return entry->size == size && entry->modified == modified ? Status::Current : Status::Changed;
+}
+
+const IngestManifest::FileEntry *IngestManifest::find(const std::string &path) const {
+    auto it = files.find(path);
+    return it != files.end() ? &it->second : nullptr;
+}
+
+void IngestManifest::record(const std::string &path, const FileEntry &entry) {
+    files[path] = entry;
+}
+
+void IngestManifest::remove(const std::string &path) {
+    auto it = files.find(path);
+    if (it == files.end()) return;
+
+    FileEntry removed = it->second;
+    files.erase(it);
+
+    for (auto &file : files) {
+        if (file.second.firstRow > removed.firstRow) {
+            file.second.firstRow -= static_cast<RowId>(removed.rowCount);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+double toRadians(double degrees) {
+    return degrees * PI / 180.0;
+}
+
+double toDegrees(double radians) {
+    return radians * 180.0 / PI;
+}
+
+// Smallest box holding every point within distanceKm of a point on the
+// sphere (the spherical cap's bounds), padded against rounding
+BoundingBox capBounds(double latitude, double longitude, double distanceKm) {
+    const double padding = 1e-6;
+    double angle = distanceKm / SpatialIndex::EARTH_RADIUS_KM;
+
+    double south = latitude - toDegrees(angle) - padding;
+    double north = latitude + toDegrees(angle) + padding;
+    if (south <= -90.0 || north >= 90.0) {
+        // The cap holds a pole, so it spans every longitude
+        return BoundingBox{std::max(south, -90.0), std::min(north, 90.0), -180.0, 180.0};
+    }
+
+    double ratio = std::sin(angle) / std::cos(toRadians(latitude));
+    if (ratio >= 1.0) {
+        return BoundingBox{south, north, -180.0, 180.0};
+    }
+
+    double spread = toDegrees(std::asin(ratio)) + padding;
+    return BoundingBox{south, north, longitude - spread, longitude + spread};
+}
+
+}
+
+void SpatialIndex::addRow(RowId row, const Point &point) {
+    // Rows without usable coordinates cannot fall in any box
+    if (!std::isfinite(point.latitude) || !std::isfinite(point.longitude)) return;
+
+    Cell &cell = cells[keyOf(cellOf(point.latitude), cellOf(point.longitude))];
+    cell.rows.push_back(row);
+
+    // A site is placed where it is first seen
+    if (siteOf.find(point.fullSiteId) == siteOf.end()) {
+        siteOf.emplace(point.fullSiteId, sites.size());
+        cell.sites.push_back(sites.size());
+        sites.push_back({point.fullSiteId, point.latitude, point.longitude, row});
+    }
+}
+
+void SpatialIndex::truncate(size_t rowCount) {
+    if (rowCount >= indexedRows) return;
+
+    // Sites are numbered in order of first sighting, so the ones first seen
+    // in dropped rows are the last sites and the last entries of their cells
+    while (!sites.empty() && sites.back().firstRow >= rowCount) {
+        const Site &site = sites.back();
+        cells[keyOf(cellOf(site.latitude), cellOf(site.longitude))].sites.pop_back();
+        siteOf.erase(site.fullSiteId);
+        sites.pop_back();
+    }
+
+    for (auto it = cells.begin(); it != cells.end();) {
+        std::vector<RowId> &rows = it->second.rows;
+        rows.erase(std::lower_bound(rows.begin(), rows.end(), static_cast<RowId>(rowCount)), rows.end());
+        it = rows.empty() && it->second.sites.empty() ? cells.erase(it) : std::next(it);
+    }
+
+    indexedRows = rowCount;
+}
+
+void SpatialIndex::clear() {
+    cells.clear();
+    sites.clear();
+    siteOf.clear();
+    indexedRows = 0;
+}
+
+std::vector<RowId> SpatialIndex::findCandidates(const BoundingBox &box) const {
+    std::vector<RowId> rows;
+    rows.reserve(countCandidates(box));
+
+    forEachCell(box, [&rows](const Cell &cell) {
+        rows.insert(rows.end(), cell.rows.begin(), cell.rows.end());
+    });
+
+    return rows;
+}
+
+size_t SpatialIndex::countCandidates(const BoundingBox &box) const {
+    size_t count = 0;
+    forEachCell(box, [&count](const Cell &cell) {
+        count += cell.rows.size();
+    });
+    return count;
+}
+
+std::vector<SpatialIndex::SiteDistance> SpatialIndex::findNearestSites(double latitude, double longitude, size_t k) const {
+    std::vector<SiteDistance> nearest;
+    if (k == 0 || sites.empty() || !std::isfinite(latitude) || !std::isfinite(longitude)) {
+        return nearest;
+    }
+    k = std::min(k, sites.size());
+
+    // Widen square rings of cells around the point until k sites are seen;
+    // once a ring is larger than the whole grid, just take every site
+    std::vector<size_t> seen;
+    std::int32_t latitudeCell = cellOf(latitude);
+    std::int32_t longitudeCell = cellOf(longitude);
+
+    for (std::int32_t ring = 0; seen.size() < k; ring++) {
+        if (double(2 * ring + 1) * double(2 * ring + 1) > 4.0 * double(cells.size())) {
+            seen.resize(sites.size());
+            for (size_t site = 0; site < sites.size(); site++) {
+                seen[site] = site;
+            }
+            break;
+        }
+
+        for (std::int32_t dLatitude = -ring; dLatitude <= ring; dLatitude++) {
+            // Interior rows of the square were visited by smaller rings
+            std::int32_t step = (dLatitude == -ring || dLatitude == ring) ? 1 : 2 * ring;
+            for (std::int32_t dLongitude = -ring; dLongitude <= ring; dLongitude += step) {
+                auto it = cells.find(keyOf(latitudeCell + dLatitude, longitudeCell + dLongitude));
+                if (it != cells.end()) {
+                    seen.insert(seen.end(), it->second.sites.begin(), it->second.sites.end());
+                }
+            }
+        }
+    }
+
+    // The k-th nearest site seen bounds the search: every closer site lies
+    // in the cap of that radius, so scan the cells under its bounding box
+    std::vector<double> distances;
+    for (size_t site : seen) {
+        distances.push_back(distanceKm(latitude, longitude, sites[site].latitude, sites[site].longitude));
+    }
+    std::nth_element(distances.begin(), distances.begin() + (k - 1), distances.end());
+    double radius = distances[k - 1];
+
+    forEachCell(capBounds(latitude, longitude, radius), [&](const Cell &cell) {
+        for (size_t site : cell.sites) {
+            double distance = distanceKm(latitude, longitude, sites[site].latitude, sites[site].longitude);
+            if (distance <= radius) {
+                nearest.push_back({sites[site].fullSiteId, sites[site].latitude, sites[site].longitude, distance});
+            }
+        }
+    });
+
+    std::sort(nearest.begin(), nearest.end(), [](const SiteDistance &a, const SiteDistance &b) {
+        return a.distanceKm != b.distanceKm ? a.distanceKm < b.distanceKm : a.fullSiteId < b.fullSiteId;
+    });
+    if (nearest.size() > k) {
+        nearest.resize(k);
+    }
+
+    return nearest;
+}
+
+// Haversine great-circle distance
+double SpatialIndex::distanceKm(double latitude1, double longitude1, double latitude2, double longitude2) {
+    double dLatitude = toRadians(latitude2 - latitude1);
+    double dLongitude = toRadians(longitude2 - longitude1);
+
+    double a = std::sin(dLatitude / 2) * std::sin(dLatitude / 2) +
+               std::cos(toRadians(latitude1)) * std::cos(toRadians(latitude2)) *
+               std::sin(dLongitude / 2) * std::sin(dLongitude / 2);
+
+    return 2 * EARTH_RADIUS_KM * std::asin(std::min(1.0, std::sqrt(a)));
+}
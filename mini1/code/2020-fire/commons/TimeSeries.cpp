@@ -0,0 +1,135 @@
+#include "TimeSeries.hpp"
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <omp.h>
+
+namespace {
+
+// Sliding-window extreme: the queue holds the indexes of points that can
+// still become the extreme, their values ordered so the front is it.
+// Each index enters and leaves once, so a series costs O(n)
+template <typename Better>
+void slidingExtreme(const std::vector<TimeSeries::Point> &input, std::vector<TimeSeries::Point> &output,
+                    std::int64_t windowSeconds, Better better) {
+    std::deque<size_t> candidates;
+
+    for (size_t i = 0; i < input.size(); i++) {
+        // A new point outlives every older one, so older ones it beats are done
+        while (!candidates.empty() && !better(input[candidates.back()].value, input[i].value)) {
+            candidates.pop_back();
+        }
+        candidates.push_back(i);
+
+        while (input[candidates.front()].timestamp <= input[i].timestamp - windowSeconds) {
+            candidates.pop_front();
+        }
+        output[i].value = input[candidates.front()].value;
+    }
+}
+
+}
+
+TimeSeries::TimeSeries(const AirQualityDataManager &manager, const std::string &pollutantType, int numThreads)
+    : pollutantType(pollutantType) {
+    const std::vector<RowId> &rows = manager.getRowIdsByPollutant(pollutantType);
+
+    // One pass over the posting list: points go to their site in row order
+    std::unordered_map<StringPool::Code, size_t> seriesOf;
+    for (RowId row : rows) {
+        const AirQualityReading &reading = manager.getReadingAt(row);
+        if (reading.getTimestamp() == AirQualityReading::NO_TIMESTAMP) continue;
+
+        auto inserted = seriesOf.emplace(reading.getFullSiteIdCode(), series.size());
+        if (inserted.second) {
+            series.push_back({reading.getFullSiteIdCode(), {}});
+        }
+        series[inserted.first->second].points.push_back({reading.getTimestamp(), reading.getValue()});
+    }
+
+    std::sort(series.begin(), series.end(), [](const Series &a, const Series &b) {
+        return a.site < b.site;
+    });
+
+    // Files load in any order; stable, so equal timestamps keep row order
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (size_t i = 0; i < series.size(); i++) {
+        std::stable_sort(series[i].points.begin(), series[i].points.end(), [](const Point &a, const Point &b) {
+            return a.timestamp < b.timestamp;
+        });
+    }
+}
+
+size_t TimeSeries::getPointCount() const {
+    size_t count = 0;
+    for (const auto &site : series) {
+        count += site.points.size();
+    }
+    return count;
+}
+
+const TimeSeries::Series *TimeSeries::findSite(const std::string &fullSiteId) const {
+    StringPool::Code site = StringPool::global().find(fullSiteId);
+    auto it = std::lower_bound(series.begin(), series.end(), site, [](const Series &entry, StringPool::Code code) {
+        return entry.site < code;
+    });
+    return it != series.end() && it->site == site ? &*it : nullptr;
+}
+
+template <typename Transform>
+std::vector<TimeSeries::Series> TimeSeries::mapSeries(Transform transform, int numThreads) const {
+    std::vector<Series> result(series.size());
+
+    // Sites range from a handful of points to thousands
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (size_t i = 0; i < series.size(); i++) {
+        result[i].site = series[i].site;
+        result[i].points = series[i].points;
+        transform(series[i].points, result[i].points);
+    }
+    return result;
+}
+
+std::vector<TimeSeries::Series> TimeSeries::rollingMean(std::int64_t windowSeconds, int numThreads) const {
+    if (windowSeconds <= 0) return {};
+
+    return mapSeries([windowSeconds](const std::vector<Point> &input, std::vector<Point> &output) {
+        double sum = 0.0;
+        size_t first = 0;
+
+        for (size_t i = 0; i < input.size(); i++) {
+            sum += input[i].value;
+            while (input[first].timestamp <= input[i].timestamp - windowSeconds) {
+                sum -= input[first++].value;
+            }
+            output[i].value = sum / (i - first + 1);
+        }
+    }, numThreads);
+}
+
+std::vector<TimeSeries::Series> TimeSeries::rollingMax(std::int64_t windowSeconds, int numThreads) const {
+    if (windowSeconds <= 0) return {};
+
+    return mapSeries([windowSeconds](const std::vector<Point> &input, std::vector<Point> &output) {
+        slidingExtreme(input, output, windowSeconds, [](double kept, double added) { return kept > added; });
+    }, numThreads);
+}
+
+std::vector<TimeSeries::Series> TimeSeries::rollingMin(std::int64_t windowSeconds, int numThreads) const {
+    if (windowSeconds <= 0) return {};
+
+    return mapSeries([windowSeconds](const std::vector<Point> &input, std::vector<Point> &output) {
+        slidingExtreme(input, output, windowSeconds, [](double kept, double added) { return kept < added; });
+    }, numThreads);
+}
+
+std::vector<TimeSeries::Series> TimeSeries::exponentialMovingAverage(double alpha, int numThreads) const {
+    return mapSeries([alpha](const std::vector<Point> &input, std::vector<Point> &output) {
+        double average = input.empty() ? 0.0 : input.front().value;
+
+        for (size_t i = 0; i < input.size(); i++) {
+            average = alpha * input[i].value + (1.0 - alpha) * average;
+            output[i].value = average;
+        }
+    }, numThreads);
+}
@@ -0,0 +1,96 @@
+#include "ZoneMaps.hpp"
+#include <algorithm>
+#include <limits>
+
+void ZoneMaps::Zone::reset() {
+    minAQI = std::numeric_limits<int>::max();
+    maxAQI = std::numeric_limits<int>::lowest();
+    minValue = std::numeric_limits<double>::max();
+    maxValue = std::numeric_limits<double>::lowest();
+    minTimestamp = std::numeric_limits<std::int64_t>::max();
+    maxTimestamp = std::numeric_limits<std::int64_t>::lowest();
+    minLatitude = std::numeric_limits<double>::max();
+    maxLatitude = std::numeric_limits<double>::lowest();
+    minLongitude = std::numeric_limits<double>::max();
+    maxLongitude = std::numeric_limits<double>::lowest();
+    minCategory = std::numeric_limits<int>::max();
+    maxCategory = std::numeric_limits<int>::lowest();
+    maxValueByPollutant.clear();
+}
+
+void ZoneMaps::Zone::include(int aqi, double value, std::int64_t timestamp,
+                             double latitude, double longitude, int category,
+                             StringPool::Code pollutant) {
+    minAQI = std::min(minAQI, aqi);
+    maxAQI = std::max(maxAQI, aqi);
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+    minTimestamp = std::min(minTimestamp, timestamp);
+    maxTimestamp = std::max(maxTimestamp, timestamp);
+    minLatitude = std::min(minLatitude, latitude);
+    maxLatitude = std::max(maxLatitude, latitude);
+    minLongitude = std::min(minLongitude, longitude);
+    maxLongitude = std::max(maxLongitude, longitude);
+    minCategory = std::min(minCategory, category);
+    maxCategory = std::max(maxCategory, category);
+
+    for (auto &entry : maxValueByPollutant) {
+        if (entry.first == pollutant) {
+            entry.second = std::max(entry.second, value);
+            return;
+        }
+    }
+    maxValueByPollutant.emplace_back(pollutant, value);
+}
+
+void ZoneMaps::truncate(size_t rowCount) {
+    if (rowCount >= summarizedRows) return;
+
+    zones.resize(rowCount / BLOCK_ROWS);
+    summarizedRows = zones.size() * BLOCK_ROWS;
+    sortBlocksByMaxValue();
+}
+
+void ZoneMaps::clear() {
+    zones.clear();
+    blocksByMaxValue.clear();
+    summarizedRows = 0;
+}
+
+std::pair<RowId, RowId> ZoneMaps::getBlockRows(size_t block) const {
+    size_t begin = block * BLOCK_ROWS;
+    size_t end = std::min(summarizedRows, begin + BLOCK_ROWS);
+    return {static_cast<RowId>(begin), static_cast<RowId>(end)};
+}
+
+std::pair<size_t, size_t> ZoneMaps::findInBlock(const std::vector<RowId> &sortedRowIds, size_t block) const {
+    std::pair<RowId, RowId> rows = getBlockRows(block);
+
+    auto first = std::lower_bound(sortedRowIds.begin(), sortedRowIds.end(), rows.first);
+    auto last = std::lower_bound(first, sortedRowIds.end(), rows.second);
+
+    return {static_cast<size_t>(first - sortedRowIds.begin()),
+            static_cast<size_t>(last - sortedRowIds.begin())};
+}
+
+const std::vector<std::pair<size_t, double>> &ZoneMaps::getBlocksByMaxValue(StringPool::Code pollutant) const {
+    static const std::vector<std::pair<size_t, double>> empty;
+    auto it = blocksByMaxValue.find(pollutant);
+    return it != blocksByMaxValue.end() ? it->second : empty;
+}
+
+void ZoneMaps::sortBlocksByMaxValue() {
+    blocksByMaxValue.clear();
+    for (size_t block = 0; block < zones.size(); block++) {
+        for (const auto &entry : zones[block].maxValueByPollutant) {
+            blocksByMaxValue[entry.first].emplace_back(block, entry.second);
+        }
+    }
+
+    for (auto &pair : blocksByMaxValue) {
+        std::stable_sort(pair.second.begin(), pair.second.end(),
+            [](const std::pair<size_t, double> &a, const std::pair<size_t, double> &b) {
+                return a.second > b.second;
+            });
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef AQI_INDEX_HPP
+#define AQI_INDEX_HPP
+
+#include <utility>
+#include <vector>
+#include "AirQualityReading.hpp"
+
+/**
+ * AQIIndex - Counting-sort permutation of rows by air quality index
+ *
+ * AQI is a small-domain integer, so rows are bucketed by value with one
+ * counting sort: every distinct AQI gets a bucket, and the buckets' offsets
+ * into one row-id permutation are kept. A range count is then a difference
+ * of two offsets (after a binary search over the distinct values), and a
+ * range fetch walks only the qualifying slice of the permutation. Within a
+ * bucket rows keep their load order.
+ *
+ * Loads add rows with ids above every indexed row, so append() counting-
+ * sorts just the new rows and merges them behind each bucket's old rows:
+ * O(old + new) copying, no re-sort, row order kept within every bucket.
+ */
+class AQIIndex {
+public:
+    // Rebuild the index from the AQI of every row (aqiByRow[rowId])
+    void build(const std::vector<int> &aqiByRow);
+
+    // Add rows firstRow, firstRow + 1, ... with AQI aqiByRow[0], aqiByRow[1], ...;
+    // firstRow must be size()
+    void append(RowId firstRow, const std::vector<int> &aqiByRow);
+
+    // Drop rows rowCount and up: each bucket loses its tail, nothing is re-sorted
+    void truncate(RowId rowCount);
+
+    void clear();
+
+    // Positions [first, second) of the rows with minAQI <= AQI <= maxAQI
+    std::pair<size_t, size_t> find(int minAQI, int maxAQI) const;
+
+    // Number of rows with minAQI <= AQI <= maxAQI
+    size_t count(int minAQI, int maxAQI) const;
+
+    // Number of rows with AQI > threshold
+    size_t countAbove(int threshold) const;
+
+    // Row ids grouped by AQI (ascending), load order within each value
+    const std::vector<RowId> &getRowIds() const { return rowIds; }
+
+    // Number of rows indexed
+    size_t size() const { return rowIds.size(); }
+
+private:
+    // Spans wider than this use binary search instead of a dense lookup table
+    static constexpr long long DENSE_SPAN_LIMIT = 1 << 20;
+
+    std::vector<int> values;         // distinct AQI values, ascending
+    std::vector<size_t> offsets;     // bucket i is rowIds[offsets[i], offsets[i + 1])
+    std::vector<RowId> rowIds;
+};
+
+#endif // AQI_INDEX_HPP
@@ -0,0 +1,120 @@
+#ifndef AIR_QUALITY_DATA_MANAGER_COLUMNAR_HPP
+#define AIR_QUALITY_DATA_MANAGER_COLUMNAR_HPP
+
+#include <vector>
+#include <map>
+#include <string>
+#include <filesystem>
+#include "AirQualityReading.hpp"
+#include "CSVParser.hpp"
+#include "TimeIndex.hpp"
+#include "AQIIndex.hpp"
+#include "ZoneMaps.hpp"
+
+namespace fs = std::filesystem;
+
+/**
+ * AirQualityDataManagerColumnar - Structure-of-arrays storage for fire data
+ *
+ * Same public API as AirQualityDataManager, but every field lives in its own
+ * contiguous column. Numeric scans (AQI filters, value aggregates) only touch
+ * the column they need instead of dragging whole readings through the cache.
+ * Readings are rebuilt from the columns only when a query has to return them.
+ */
+class AirQualityDataManagerColumnar {
+private:
+    // Numeric columns
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+    std::vector<double> values;
+    std::vector<double> rawConcentrations;
+    std::vector<std::int64_t> timestamps;
+    std::vector<int> airQualityIndexes;
+    std::vector<int> categories;
+
+    // String columns, dictionary-encoded in StringPool::global()
+    std::vector<StringPool::Code> datetimes;
+    std::vector<StringPool::Code> pollutantTypes;
+    std::vector<StringPool::Code> units;
+    std::vector<StringPool::Code> siteNames;
+    std::vector<StringPool::Code> agencyNames;
+    std::vector<StringPool::Code> siteIds;
+    std::vector<StringPool::Code> fullSiteIds;
+
+    // Indexes hold row positions into the columns, keyed by dictionary code
+    std::map<StringPool::Code, std::vector<RowId>> rowsByDate;
+    std::map<StringPool::Code, std::vector<RowId>> rowsByPollutant;
+    
+    // Rows sorted by epoch timestamp; rows from timeIndexedRows on are not in it yet
+    TimeIndex timeIndex;
+    size_t timeIndexedRows = 0;
+    
+    // Rows bucketed by AQI value (counting sort), new rows merged in after every load
+    AQIIndex aqiIndex;
+    
+    // Min/max of each 4K-row block, extended after every load
+    ZoneMaps zoneMaps;
+
+    const std::vector<RowId> &getRowsByPollutant(const std::string &pollutantType) const;
+
+    void appendReading(const AirQualityReading &reading);
+    void appendShards(std::vector<std::vector<AirQualityReading>> &shards);
+    void updateIndexes();
+    AirQualityReading getReadingAt(size_t row) const;
+
+    CSVReadMode readMode = CSVReadMode::Stream;
+
+public:
+    // Choose how CSV files are read (default: Stream)
+    void setReadMode(CSVReadMode mode) { readMode = mode; }
+    
+    void loadFromCSV(const std::string &filename);
+    void loadFromDateFolder(const std::string &dateFolderPath);
+    void loadFromDirectory(const std::string &rootPath);
+    
+    void loadFromDirectoryParallel(const std::string &rootPath, int numThreads = 4);
+    
+    // Intra-file parallelism: files are mmapped and split into byte ranges,
+    // rows keep the order of loading the (sorted) files serially
+    void loadFromCSVParallel(const std::string &filename, int numThreads = 4);
+    void loadFromDirectoryByteRanges(const std::string &rootPath, int numThreads = 4);
+    
+    void clear();
+
+    std::vector<AirQualityReading> getAllReadings() const;
+    int getReadingCount() const;
+    
+    std::vector<AirQualityReading> getReadingsByDate(const std::string &date) const;
+    std::vector<AirQualityReading> getReadingsByPollutant(const std::string &pollutantType) const;
+    
+    // Readings with start <= timestamp < end (UTC epoch seconds)
+    std::vector<AirQualityReading> getReadingsByTimeRange(std::int64_t start, std::int64_t end) const;
+    const TimeIndex &getTimeIndex() const;
+    
+    std::vector<AirQualityReading> getReadingsByAQIRange(int minAQI, int maxAQI) const;
+    
+    std::vector<AirQualityReading> getReadingsByAQIRangeParallel(int minAQI, int maxAQI) const;
+    
+    // Selection vectors: ascending rows whose column lies in [min, max],
+    // found by the SIMD filter kernels (FilterKernels) over the blocks the
+    // zone maps cannot rule out. Nothing is copied until getReadingsAt()
+    std::vector<RowId> selectRowsByAQIRange(int minAQI, int maxAQI) const;
+    std::vector<RowId> selectRowsByValueRange(double minValue, double maxValue) const;
+    std::vector<RowId> selectRowsByCategory(int minCategory, int maxCategory) const;
+    
+    // Rebuild the readings of a selection vector, in its order
+    std::vector<AirQualityReading> getReadingsAt(const std::vector<RowId> &rows) const;
+    
+    double getAveragePollutantValue(const std::string &pollutantType) const;
+    double getMaxPollutantValue(const std::string &pollutantType) const;
+    int countReadingsAboveAQI(int threshold) const;
+    
+    double getAveragePollutantValueParallel(const std::string &pollutantType) const;
+    double getMaxPollutantValueParallel(const std::string &pollutantType) const;
+    int countReadingsAboveAQIParallel(int threshold) const;
+    
+    std::vector<std::string> getAllDates() const;
+    std::vector<std::string> getAllPollutantTypes() const;
+};
+
+#endif // AIR_QUALITY_DATA_MANAGER_COLUMNAR_HPP
@@ -0,0 +1,87 @@
+#ifndef AIR_QUALITY_DATA_MANAGER_SHARDED_HPP
+#define AIR_QUALITY_DATA_MANAGER_SHARDED_HPP
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <omp.h>
+#include "AirQualityDataManager.hpp"
+#include "NumaTopology.hpp"
+
+/**
+ * AirQualityDataManagerSharded - One AirQualityDataManager per NUMA node
+ *
+ * The sorted CSV files are split into contiguous runs of about equal bytes,
+ * one per shard, and every shard is loaded and queried only by threads
+ * bound to its node. Readings and indexes are therefore first touched - and
+ * backed - by local memory, and scans never cross the interconnect. Each
+ * query runs on all nodes at once and the per-shard answers are merged.
+ *
+ * Shard s holds rows from earlier files than shard s + 1, so results that
+ * are concatenated (getReadingsByAQIRange) keep file order between shards.
+ */
+class AirQualityDataManagerSharded {
+private:
+    struct Shard {
+        NumaTopology::Node node;
+        AirQualityDataManager data;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+public:
+    // One shard per NUMA node of this machine
+    AirQualityDataManagerSharded();
+
+    // One shard per given node, e.g. several shards on a single-node machine
+    explicit AirQualityDataManagerSharded(const std::vector<NumaTopology::Node> &nodes);
+
+    void loadFromDirectory(const std::string &rootPath);
+    void loadFromCSVFiles(const std::vector<std::string> &filenames);
+    void clear();
+
+    size_t getShardCount() const { return shards.size(); }
+    const AirQualityDataManager &getShard(size_t shard) const { return shards[shard]->data; }
+    const NumaTopology::Node &getShardNode(size_t shard) const { return shards[shard]->node; }
+
+    /**
+     * Run fn(shard) for every shard at once, each on its own thread bound to
+     * the shard's node; OpenMP teams started inside fn inherit the binding
+     * and are sized to the node's CPUs
+     */
+    template <typename Fn>
+    void runOnNodes(Fn fn) const;
+
+    int getReadingCount() const;
+    double getAveragePollutantValue(const std::string &pollutantType) const;
+    double getMaxPollutantValue(const std::string &pollutantType) const;
+    int countReadingsAboveAQI(int threshold) const;
+
+    // Owning copies gathered on each node, concatenated in shard order
+    std::vector<AirQualityReading> getReadingsByAQIRange(int minAQI, int maxAQI) const;
+
+    // Per-shard group-by tables merged by key
+    std::vector<GroupBy::Row> groupBy(unsigned columns) const;
+};
+
+template <typename Fn>
+void AirQualityDataManagerSharded::runOnNodes(Fn fn) const {
+    std::vector<std::thread> threads;
+    threads.reserve(shards.size());
+
+    for (size_t shard = 0; shard < shards.size(); shard++) {
+        threads.emplace_back([this, &fn, shard] {
+            const NumaTopology::Node &node = shards[shard]->node;
+            NumaTopology::bindCurrentThread(node.cpus);
+            omp_set_num_threads(static_cast<int>(node.cpus.size()));
+            fn(shard);
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+#endif // AIR_QUALITY_DATA_MANAGER_SHARDED_HPP
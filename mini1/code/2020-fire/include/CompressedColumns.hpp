@@ -0,0 +1,80 @@
+#ifndef COMPRESSED_COLUMNS_HPP
+#define COMPRESSED_COLUMNS_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AirQualityReading.hpp"
+#include "ColumnEncoding.hpp"
+
+/**
+ * CompressedColumns - The numeric columns of the fire data, encoded
+ *
+ * Holds what scans and aggregates read (timestamp, AQI, category,
+ * pollutant, value, raw concentration) in ColumnEncoding blocks instead of
+ * plain vectors, for a worker that has to keep a long window in memory.
+ * Files are parsed and encoded in batches of about LOAD_BATCH_BYTES of CSV,
+ * so the rows ever held as AirQualityReadings are one batch's worth, not
+ * the whole dataset (a file larger than a batch is held whole).
+ *
+ * Every query walks the blocks in order, decodes only the columns it reads
+ * into per-block buffers and runs its kernel there. AQI and category
+ * predicates first check the frame-of-reference min/max of a block, which
+ * doubles as a zone map.
+ */
+class CompressedColumns {
+private:
+    ColumnEncoding::DeltaColumn timestamps;
+    ColumnEncoding::ForColumn airQualityIndexes;
+    ColumnEncoding::ForColumn categories;
+    ColumnEncoding::ForColumn pollutantTypes;     // StringPool codes
+    ColumnEncoding::DoubleColumn values;
+    ColumnEncoding::DoubleColumn rawConcentrations;
+
+    // Sum and count (or max) of one pollutant's values in a block
+    void scanPollutantBlock(size_t block, StringPool::Code pollutant,
+                            double &sum, size_t &count, double &maxValue) const;
+
+    // CSV bytes parsed before their readings are encoded and dropped
+    static constexpr size_t LOAD_BATCH_BYTES = 64 * 1024 * 1024;
+
+public:
+    static constexpr size_t BLOCK_ROWS = ColumnEncoding::BLOCK_ROWS;
+
+    void append(const AirQualityReading &reading);
+    void append(const std::vector<AirQualityReading> &readings);
+
+    // Parse files on numThreads threads, appending readings in file order;
+    // a batch of files is encoded before the next one is parsed
+    int loadFromCSVFiles(const std::vector<std::string> &filenames, int numThreads = 4);
+    int loadFromDirectory(const std::string &rootPath, int numThreads = 4);
+
+    void clear();
+
+    // Give back the growth slack of the encoded columns once loading is done
+    void shrinkToFit();
+
+    int getReadingCount() const;
+
+    // Encoded size vs the same columns as plain vectors
+    size_t memoryBytes() const;
+    size_t plainBytes() const;
+
+    // Ascending rows with the column in [min, max], as in the columnar store
+    std::vector<RowId> selectRowsByAQIRange(int minAQI, int maxAQI) const;
+    std::vector<RowId> selectRowsByCategory(int minCategory, int maxCategory) const;
+
+    int countReadingsAboveAQI(int threshold) const;
+
+    // Readings with start <= timestamp < end (UTC epoch seconds)
+    int countReadingsByTimeRange(std::int64_t start, std::int64_t end) const;
+
+    double getAveragePollutantValue(const std::string &pollutantType) const;
+    double getMaxPollutantValue(const std::string &pollutantType) const;
+
+    // Blocks are split across threads, each decoding into its own buffers
+    double getAveragePollutantValueParallel(const std::string &pollutantType) const;
+    int countReadingsAboveAQIParallel(int threshold) const;
+};
+
+#endif // COMPRESSED_COLUMNS_HPP
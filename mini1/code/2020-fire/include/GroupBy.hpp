@@ -0,0 +1,115 @@
+#ifndef GROUP_BY_HPP
+#define GROUP_BY_HPP
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <omp.h>
+#include "AirQualityReading.hpp"
+#include "RollupCube.hpp"
+
+/**
+ * GroupBy - Value statistics per group in one parallel scan
+ *
+ * A group is any combination of pollutant, site, date and AQI category,
+ * chosen with a bitmask such as GroupBy::Pollutant | GroupBy::Site. Each
+ * thread aggregates a contiguous share of the rows into its own hash
+ * table; the tables are merged in thread order, and the result is one
+ * row per group sorted by key.
+ */
+namespace GroupBy {
+
+enum Column : unsigned {
+    Pollutant = 1u << 0,
+    Site = 1u << 1,
+    Date = 1u << 2,
+    Category = 1u << 3
+};
+
+// Columns that are not grouped on hold StringPool::NOT_FOUND (category -1)
+struct Key {
+    StringPool::Code pollutant = StringPool::NOT_FOUND;
+    StringPool::Code site = StringPool::NOT_FOUND;
+    StringPool::Code date = StringPool::NOT_FOUND;
+    int category = -1;
+
+    bool operator==(const Key &other) const {
+        return pollutant == other.pollutant && site == other.site &&
+               date == other.date && category == other.category;
+    }
+
+    bool operator<(const Key &other) const {
+        return std::tie(pollutant, site, date, category) <
+               std::tie(other.pollutant, other.site, other.date, other.category);
+    }
+};
+
+struct KeyHash {
+    size_t operator()(const Key &key) const {
+        std::uint64_t hash = (std::uint64_t(key.pollutant) << 32) ^ key.site;
+        hash = hash * 0x9E3779B97F4A7C15ULL ^ ((std::uint64_t(key.date) << 8) | std::uint8_t(key.category));
+        return static_cast<size_t>(hash ^ (hash >> 31));
+    }
+};
+
+struct Row {
+    Key key;
+    RollupCube::Stats stats;    // count, sum, min, max; mean() from there
+};
+
+// The key of reading with only the columns selected by columns filled in
+inline Key keyOf(const AirQualityReading &reading, unsigned columns) {
+    Key key;
+    if (columns & Pollutant) key.pollutant = reading.getPollutantTypeCode();
+    if (columns & Site) key.site = reading.getFullSiteIdCode();
+    if (columns & Date) key.date = reading.getDatetimeCode();
+    if (columns & Category) key.category = reading.getCategory();
+    return key;
+}
+
+/**
+ * Group rows [0, count): readingAt(row) returns the reading of a row.
+ * numThreads 1 is a serial scan in row order.
+ */
+template <typename ReadingAt>
+std::vector<Row> aggregate(size_t count, unsigned columns, ReadingAt readingAt, int numThreads) {
+    using Table = std::unordered_map<Key, RollupCube::Stats, KeyHash>;
+    std::vector<Table> tables(std::max(numThreads, 1));
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        int thread = omp_get_thread_num();
+        int threads = omp_get_num_threads();
+        size_t begin = count * thread / threads;
+        size_t end = count * (thread + 1) / threads;
+
+        Table &table = tables[thread];
+        for (size_t row = begin; row < end; row++) {
+            const AirQualityReading &reading = readingAt(static_cast<RowId>(row));
+            table[keyOf(reading, columns)].add(reading.getValue());
+        }
+    }
+
+    Table &merged = tables[0];
+    for (size_t thread = 1; thread < tables.size(); thread++) {
+        for (const auto &group : tables[thread]) {
+            merged[group.first].merge(group.second);
+        }
+        Table().swap(tables[thread]);
+    }
+
+    std::vector<Row> result;
+    result.reserve(merged.size());
+    for (const auto &group : merged) {
+        result.push_back({group.first, group.second});
+    }
+    std::sort(result.begin(), result.end(), [](const Row &a, const Row &b) {
+        return a.key < b.key;
+    });
+    return result;
+}
+
+}
+
+#endif // GROUP_BY_HPP
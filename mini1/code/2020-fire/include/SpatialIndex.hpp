@@ -0,0 +1,143 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "AirQualityReading.hpp"
+#include "AirQualityQuery.hpp"
+
+/**
+ * SpatialIndex - Uniform lat/lon grid over rows and monitoring sites
+ *
+ * Each CELL_DEGREES x CELL_DEGREES cell keeps the ids of the rows located
+ * in it (ascending) and the sites first seen in it. A bounding box touches
+ * only the cells it overlaps; rows in border cells still need their own
+ * coordinates checked. Nearest-site searches widen rings of cells around
+ * the point until k sites are found, then scan the cells within the
+ * k-th distance. Only occupied cells are stored. Boxes do not wrap
+ * around the antimeridian.
+ */
+class SpatialIndex {
+public:
+    static constexpr double CELL_DEGREES = 0.25;
+    static constexpr double EARTH_RADIUS_KM = 6371.0088;
+
+    // Where a row is and which site reported it
+    struct Point {
+        double latitude;
+        double longitude;
+        StringPool::Code fullSiteId;
+    };
+
+    struct SiteDistance {
+        StringPool::Code fullSiteId;
+        double latitude;
+        double longitude;
+        double distanceKm;
+    };
+
+    /**
+     * Index rows added since the last call; rowCount is the new total.
+     * pointOf(row) must return the row's Point.
+     */
+    template <typename PointOf>
+    void update(size_t rowCount, PointOf pointOf);
+
+    // Drop rows rowCount and up (the most recently indexed), and the sites
+    // first seen in them; each cell only loses the tail of its lists
+    void truncate(size_t rowCount);
+
+    void clear();
+
+    // Rows of every cell overlapping box (a superset of the rows inside it),
+    // grouped by cell, and how many there are without collecting them
+    std::vector<RowId> findCandidates(const BoundingBox &box) const;
+    size_t countCandidates(const BoundingBox &box) const;
+
+    // The k sites closest to a point by great-circle distance, nearest first
+    std::vector<SiteDistance> findNearestSites(double latitude, double longitude, size_t k) const;
+
+    size_t getSiteCount() const { return sites.size(); }
+
+    static double distanceKm(double latitude1, double longitude1, double latitude2, double longitude2);
+
+private:
+    struct Cell {
+        std::vector<RowId> rows;
+        std::vector<size_t> sites;
+    };
+
+    struct Site {
+        StringPool::Code fullSiteId;
+        double latitude;
+        double longitude;
+        RowId firstRow;     // where it was first seen
+    };
+
+    std::unordered_map<std::int64_t, Cell> cells;
+    std::vector<Site> sites;
+    std::unordered_map<StringPool::Code, size_t> siteOf;
+    size_t indexedRows = 0;
+
+    // Clamped so that garbage coordinates (and unbounded boxes) still map
+    // to a cell; clamping is monotone, so box candidates stay a superset
+    static std::int32_t cellOf(double degrees) {
+        degrees = std::max(-10000.0, std::min(10000.0, degrees));
+        return static_cast<std::int32_t>(std::floor(degrees / CELL_DEGREES));
+    }
+    static std::int64_t keyOf(std::int32_t latitudeCell, std::int32_t longitudeCell) {
+        return (static_cast<std::int64_t>(latitudeCell) << 32) | static_cast<std::uint32_t>(longitudeCell);
+    }
+
+    void addRow(RowId row, const Point &point);
+
+    // Call visit(cell) for every occupied cell overlapping box
+    template <typename Visit>
+    void forEachCell(const BoundingBox &box, Visit visit) const;
+};
+
+template <typename PointOf>
+void SpatialIndex::update(size_t rowCount, PointOf pointOf) {
+    for (size_t row = indexedRows; row < rowCount; row++) {
+        addRow(static_cast<RowId>(row), pointOf(static_cast<RowId>(row)));
+    }
+    indexedRows = std::max(indexedRows, rowCount);
+}
+
+template <typename Visit>
+void SpatialIndex::forEachCell(const BoundingBox &box, Visit visit) const {
+    if (!(box.south <= box.north && box.west <= box.east)) return;
+
+    std::int32_t south = cellOf(box.south);
+    std::int32_t north = cellOf(box.north);
+    std::int32_t west = cellOf(box.west);
+    std::int32_t east = cellOf(box.east);
+
+    // A box wider than the occupied grid is cheaper to test cell by cell
+    double boxCells = (double(north) - south + 1) * (double(east) - west + 1);
+    if (boxCells > double(cells.size())) {
+        for (const auto &pair : cells) {
+            std::int32_t latitudeCell = static_cast<std::int32_t>(pair.first >> 32);
+            std::int32_t longitudeCell = static_cast<std::int32_t>(static_cast<std::uint32_t>(pair.first));
+            if (latitudeCell >= south && latitudeCell <= north &&
+                longitudeCell >= west && longitudeCell <= east) {
+                visit(pair.second);
+            }
+        }
+        return;
+    }
+
+    for (std::int32_t latitudeCell = south; latitudeCell <= north; latitudeCell++) {
+        for (std::int32_t longitudeCell = west; longitudeCell <= east; longitudeCell++) {
+            auto it = cells.find(keyOf(latitudeCell, longitudeCell));
+            if (it != cells.end()) {
+                visit(it->second);
+            }
+        }
+    }
+}
+
+#endif // SPATIAL_INDEX_HPP
@@ -0,0 +1,68 @@
+#ifndef TIME_INDEX_HPP
+#define TIME_INDEX_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "AirQualityReading.hpp"
+
+/**
+ * TimeIndex - Row ids sorted by epoch timestamp
+ *
+ * Rows are kept ordered by (timestamp, row id), so any time range is one
+ * contiguous slice found with two binary searches. Hour and day boundaries
+ * (UTC) are recomputed whenever rows are added, so calendar rollups can walk
+ * buckets without searching at all.
+ */
+class TimeIndex {
+public:
+    static constexpr std::int64_t HOUR = 3600;
+    static constexpr std::int64_t DAY = 86400;
+
+    // One calendar bucket: positions [begin, end) of the index with
+    // start <= timestamp < start + HOUR (or DAY)
+    struct Bucket {
+        std::int64_t start;
+        size_t begin;
+        size_t end;
+    };
+
+    /**
+     * Add rows to the index. Entries are (timestamp, row id) pairs whose row
+     * ids are all larger than any already indexed (rows appended since the
+     * last call); they are sorted and merged in, and the buckets rebuilt.
+     */
+    void append(std::vector<std::pair<std::int64_t, RowId>> entries);
+
+    // Replace the index with rows already in (timestamp, row id) order, e.g.
+    // from a snapshot; returns false (leaving the index empty) if they are not
+    bool assign(std::vector<std::int64_t> sortedTimestamps, std::vector<RowId> sortedRowIds);
+
+    // Drop rows rowCount and up (the most recently appended); the rest keep
+    // their order, so this is one compacting pass with no re-sort
+    void truncate(RowId rowCount);
+
+    void clear();
+
+    // Positions [first, second) of the rows with start <= timestamp < end
+    std::pair<size_t, size_t> find(std::int64_t start, std::int64_t end) const;
+
+    size_t size() const { return rowIds.size(); }
+
+    // Row ids and their timestamps, both in time order
+    const std::vector<RowId> &getRowIds() const { return rowIds; }
+    const std::vector<std::int64_t> &getTimestamps() const { return timestamps; }
+
+    const std::vector<Bucket> &getHourBuckets() const { return hourBuckets; }
+    const std::vector<Bucket> &getDayBuckets() const { return dayBuckets; }
+
+private:
+    std::vector<std::int64_t> timestamps;
+    std::vector<RowId> rowIds;
+    std::vector<Bucket> hourBuckets;
+    std::vector<Bucket> dayBuckets;
+
+    void rebuildBuckets(std::vector<Bucket> &buckets, std::int64_t width) const;
+};
+
+#endif // TIME_INDEX_HPP
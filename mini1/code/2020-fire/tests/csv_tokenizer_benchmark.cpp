@@ -0,0 +1,174 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "CSVParser.hpp"
+#include "CSVTokenizer.hpp"
+#include "BenchMarkTimer.hpp"
+
+namespace fs = std::filesystem;
+
+void printSeparator() {
+    std::cout << "================================================" << std::endl;
+}
+
+// Read every CSV under root into one buffer (files joined end to end)
+std::string readTree(const std::string &root) {
+    std::string buffer;
+    try {
+        for (const auto &entry : fs::recursive_directory_iterator(root)) {
+            if (entry.path().extension() == ".csv") {
+                std::ifstream file(entry.path());
+                std::stringstream contents;
+                contents << file.rdbuf();
+                buffer += contents.str();
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading " << root << ": " << e.what() << std::endl;
+    }
+    return buffer;
+}
+
+std::vector<std::string> splitLines(const std::string &buffer) {
+    std::vector<std::string> lines;
+    std::istringstream stream(buffer);
+    std::string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// Every parser must agree with the character-at-a-time reference
+bool checkLines(const std::string &name, const std::vector<std::string> &lines) {
+    size_t mismatches = 0;
+    std::vector<std::string_view> views;
+    
+    for (const auto &line : lines) {
+        auto expected = CSVParser::parseLineScalar(line);
+        
+        if (CSVParser::parseLine(line) != expected) {
+            mismatches++;
+            continue;
+        }
+        if (CSVParser::parseLineView(line, views)) {
+            if (views.size() != expected.size()) {
+                mismatches++;
+                continue;
+            }
+            for (size_t i = 0; i < views.size(); i++) {
+                if (views[i] != expected[i]) {
+                    mismatches++;
+                    break;
+                }
+            }
+        }
+    }
+    
+    std::cout << "[" << name << "] " << lines.size() << " lines, " 
+              << mismatches << " mismatches vs reference parser" << std::endl;
+    return mismatches == 0;
+}
+
+void report(const std::string &name, size_t bytes, long long micros) {
+    double mbPerSec = micros > 0 ? (bytes / (double)micros) : 0.0;  // bytes/μs == MB/s
+    std::cout << "  " << std::left << std::setw(28) << name << std::right
+              << std::setw(8) << micros / 1000 << " ms  "
+              << std::fixed << std::setprecision(1) << std::setw(8) << mbPerSec << " MB/s" << std::endl;
+}
+
+void benchmarkParsers(const std::string &buffer, const std::vector<std::string> &lines) {
+    std::cout << "\n[THROUGHPUT] " << buffer.size() / (1024 * 1024) << " MB, " 
+              << lines.size() << " lines" << std::endl;
+    
+    size_t fieldCount = 0;
+    
+    BenchmarkTimer scalarTimer;
+    scalarTimer.start();
+    for (const auto &line : lines) {
+        fieldCount += CSVParser::parseLineScalar(line).size();
+    }
+    scalarTimer.stop();
+    report("parseLine (char-at-a-time)", buffer.size(), scalarTimer.getMicroseconds());
+    
+    BenchmarkTimer lineTimer;
+    lineTimer.start();
+    for (const auto &line : lines) {
+        fieldCount += CSVParser::parseLine(line).size();
+    }
+    lineTimer.stop();
+    report("parseLine (tokenizer)", buffer.size(), lineTimer.getMicroseconds());
+    
+    std::vector<std::string_view> views;
+    BenchmarkTimer viewTimer;
+    viewTimer.start();
+    for (const auto &line : lines) {
+        CSVParser::parseLineView(line, views);
+        fieldCount += views.size();
+    }
+    viewTimer.stop();
+    report("parseLineView (tokenizer)", buffer.size(), viewTimer.getMicroseconds());
+    
+    // Raw tokenizer over the whole buffer, one kernel at a time
+    std::vector<CSVTokenizer::Kernel> kernels = {CSVTokenizer::Kernel::Scalar};
+    if (CSVTokenizer::bestKernel() != CSVTokenizer::Kernel::Scalar) {
+        kernels.push_back(CSVTokenizer::Kernel::SSE2);
+    }
+    if (CSVTokenizer::bestKernel() == CSVTokenizer::Kernel::AVX2) {
+        kernels.push_back(CSVTokenizer::Kernel::AVX2);
+    }
+    
+    std::vector<size_t> fieldEnds;
+    for (auto kernel : kernels) {
+        size_t ends = 0;
+        BenchmarkTimer kernelTimer;
+        kernelTimer.start();
+        for (size_t pos = 0; pos < buffer.size(); ) {
+            fieldEnds.clear();
+            pos = CSVTokenizer::scanRecord(buffer, pos, fieldEnds, kernel) + 1;
+            ends += fieldEnds.size();
+        }
+        kernelTimer.stop();
+        report(std::string("scanRecord (") + CSVTokenizer::kernelName(kernel) + ")",
+               buffer.size(), kernelTimer.getMicroseconds());
+        fieldCount += ends;
+    }
+    
+    std::cout << "  (fields seen: " << fieldCount << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "\n";
+    printSeparator();
+    std::cout << "  CSV TOKENIZER MICROBENCHMARK" << std::endl;
+    printSeparator();
+    std::cout << "Active kernel: " << CSVTokenizer::kernelName(CSVTokenizer::bestKernel()) << std::endl;
+    
+    std::string fireBuffer = readTree("../../../data/2020-fire/data");
+    auto fireLines = splitLines(fireBuffer);
+    
+    std::string worldBankBuffer = readTree("../../../data/worldbank");
+    auto worldBankLines = splitLines(worldBankBuffer);
+    
+    std::cout << "\n=== CORRECTNESS ===" << std::endl;
+    bool ok = checkLines("2020-fire", fireLines);
+    ok = checkLines("worldbank", worldBankLines) && ok;
+    
+    std::cout << "\n=== 2020-FIRE ===" << std::endl;
+    benchmarkParsers(fireBuffer, fireLines);
+    
+    if (!worldBankLines.empty()) {
+        std::cout << "\n=== WORLDBANK ===" << std::endl;
+        benchmarkParsers(worldBankBuffer, worldBankLines);
+    }
+    
+    std::cout << "\n";
+    printSeparator();
+    std::cout << (ok ? "✓ All parsers agree" : "✗ Parsers disagree!") << std::endl;
+    
+    return ok ? 0 : 1;
+}
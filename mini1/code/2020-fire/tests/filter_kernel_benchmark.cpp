@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include "AirQualityDataManagerColumnar.hpp"
+#include "CompressedColumns.hpp"
+#include "FilterKernels.hpp"
+#include "BenchMarkTimer.hpp"
+
+void printSeparator() {
+    std::cout << "================================================" << std::endl;
+}
+
+// Kernels the running CPU can execute, slowest first
+std::vector<FilterKernels::Kernel> availableKernels() {
+    std::vector<FilterKernels::Kernel> kernels = {FilterKernels::Kernel::Scalar};
+    if (FilterKernels::bestKernel() != FilterKernels::Kernel::Scalar) {
+        kernels.push_back(FilterKernels::Kernel::AVX2);
+    }
+    if (FilterKernels::bestKernel() == FilterKernels::Kernel::AVX512) {
+        kernels.push_back(FilterKernels::Kernel::AVX512);
+    }
+    return kernels;
+}
+
+// Every kernel must produce the same selection vector as a plain loop
+template <typename T>
+bool checkKernels(const std::string &name, const std::vector<T> &column, T low, T high) {
+    std::vector<std::uint32_t> expected;
+    for (size_t i = 0; i < column.size(); i++) {
+        if (column[i] >= low && column[i] <= high) {
+            expected.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+
+    bool ok = true;
+    std::vector<std::uint32_t> selected(column.size());
+    for (auto kernel : availableKernels()) {
+        size_t count = FilterKernels::selectRange(column.data(), column.size(), low, high, 0, selected.data(), kernel);
+        selected.resize(count);
+        ok = ok && selected == expected &&
+             FilterKernels::countRange(column.data(), column.size(), low, high, kernel) == expected.size();
+        selected.resize(column.size());
+    }
+
+    std::cout << "[" << name << "] " << expected.size() << " of " << column.size()
+              << " rows, kernels " << (ok ? "agree" : "DISAGREE") << std::endl;
+    return ok;
+}
+
+template <typename T>
+void benchmarkKernels(const std::string &name, const std::vector<T> &column, T low, T high) {
+    std::cout << "\n[SELECT " << name << "]" << std::endl;
+
+    std::vector<std::uint32_t> selected(column.size());
+    for (auto kernel : availableKernels()) {
+        BenchmarkTimer timer;
+        timer.start();
+        size_t count = FilterKernels::selectRange(column.data(), column.size(), low, high, 0, selected.data(), kernel);
+        timer.stop();
+
+        std::cout << "  " << std::left << std::setw(10) << FilterKernels::kernelName(kernel) << std::right
+                  << std::setw(8) << timer.getMicroseconds() << " μs  (" << count << " rows)" << std::endl;
+    }
+}
+
+int main() {
+    std::cout << "\n";
+    printSeparator();
+    std::cout << "  FILTER KERNEL MICROBENCHMARK" << std::endl;
+    printSeparator();
+    std::cout << "Active kernel: " << FilterKernels::kernelName(FilterKernels::bestKernel()) << std::endl;
+
+    AirQualityDataManagerColumnar manager;
+    manager.loadFromDirectoryByteRanges("../../../data/2020-fire/data", 4);
+
+    // Plain columns for the raw kernels; the manager's own are private
+    std::vector<AirQualityReading> readings = manager.getAllReadings();
+    std::vector<int> aqis;
+    std::vector<double> values;
+    std::vector<int> categories;
+    for (const auto &reading : readings) {
+        aqis.push_back(reading.getAirQualityIndex());
+        values.push_back(reading.getValue());
+        categories.push_back(reading.getCategory());
+    }
+
+    std::cout << "\n=== CORRECTNESS ===" << std::endl;
+    bool ok = checkKernels("AQI 51-100", aqis, 51, 100);
+    ok = checkKernels("value 10-50", values, 10.0, 50.0) && ok;
+    ok = checkKernels("category 3-6", categories, 3, 6) && ok;
+
+    auto selectedRows = manager.selectRowsByAQIRange(51, 100);
+    ok = ok && selectedRows.size() == manager.getReadingsByAQIRange(51, 100).size();
+    std::cout << "[Columnar AQI 51-100] " << selectedRows.size() << " rows, matches AQI index: "
+              << (ok ? "yes" : "NO") << std::endl;
+
+    std::cout << "\n=== RAW KERNELS ===" << std::endl;
+    benchmarkKernels("AQI 51-100", aqis, 51, 100);
+    benchmarkKernels("value 10-50", values, 10.0, 50.0);
+    benchmarkKernels("category 3-6", categories, 3, 6);
+
+    // What the scan used to do: a getter per reading, a copy per hit
+    std::cout << "\n=== SELECTION VECTOR VS COPYING SCAN (AQI 51-100) ===" << std::endl;
+
+    BenchmarkTimer copyTimer;
+    copyTimer.start();
+    std::vector<AirQualityReading> copied;
+    for (const auto &reading : readings) {
+        int aqi = reading.getAirQualityIndex();
+        if (aqi >= 51 && aqi <= 100) {
+            copied.push_back(reading);
+        }
+    }
+    copyTimer.stop();
+
+    BenchmarkTimer selectTimer;
+    selectTimer.start();
+    auto rows = manager.selectRowsByAQIRange(51, 100);
+    selectTimer.stop();
+
+    BenchmarkTimer gatherTimer;
+    gatherTimer.start();
+    auto gathered = manager.getReadingsAt(rows);
+    gatherTimer.stop();
+
+    std::cout << "  Copying scan:      " << copyTimer.getMicroseconds() << " μs (" << copied.size() << " readings)" << std::endl;
+    std::cout << "  Selection vector:  " << selectTimer.getMicroseconds() << " μs (" << rows.size() << " rows)" << std::endl;
+    std::cout << "  Gather on demand:  " << gatherTimer.getMicroseconds() << " μs" << std::endl;
+    ok = ok && gathered.size() == copied.size();
+
+    // Same scans over encoded columns: each block is decoded just before its kernel runs
+    std::cout << "\n=== COMPRESSED VS PLAIN COLUMNS ===" << std::endl;
+
+    CompressedColumns compressed;
+    compressed.append(readings);
+    compressed.shrinkToFit();
+    std::cout << "  Encoded: " << compressed.memoryBytes() / 1024 << " KB, plain: "
+              << compressed.plainBytes() / 1024 << " KB" << std::endl;
+
+    BenchmarkTimer compressedSelectTimer;
+    compressedSelectTimer.start();
+    auto compressedRows = compressed.selectRowsByAQIRange(51, 100);
+    compressedSelectTimer.stop();
+
+    BenchmarkTimer plainAverageTimer;
+    plainAverageTimer.start();
+    double plainAverage = manager.getAveragePollutantValue("PM2.5");
+    plainAverageTimer.stop();
+
+    BenchmarkTimer compressedAverageTimer;
+    compressedAverageTimer.start();
+    double compressedAverage = compressed.getAveragePollutantValue("PM2.5");
+    compressedAverageTimer.stop();
+
+    std::cout << "  AQI 51-100 plain:       " << selectTimer.getMicroseconds() << " μs, compressed: "
+              << compressedSelectTimer.getMicroseconds() << " μs" << std::endl;
+    std::cout << "  PM2.5 average plain:    " << plainAverageTimer.getMicroseconds() << " μs, compressed: "
+              << compressedAverageTimer.getMicroseconds() << " μs" << std::endl;
+    ok = ok && compressedRows == rows && std::abs(compressedAverage - plainAverage) <= 1e-9 * std::max(1.0, plainAverage);
+
+    std::cout << "\n";
+    printSeparator();
+    std::cout << (ok ? "✓ All kernels agree" : "✗ Kernels disagree!") << std::endl;
+
+    return ok ? 0 : 1;
+}
@@ -1,11 +1,34 @@
 #include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <map>
+#include <cmath>
+#include <atomic>
+#include <cstring>
+#include <random>
 #include "AirQualityDataManager.hpp"
+#include "StreamingAggregation.hpp"
+#include "AirQualityDataManagerSharded.hpp"
+#include "CompressedColumns.hpp"
+#include "TimeSeries.hpp"
 #include "BenchMarkTimer.hpp"
+#include "ThreadPool.hpp"
 
 void printSeparator() {
     std::cout << "================================================" << std::endl;
 }
 
+// Checks that did not hold; main() fails the run if there are any
+int failedChecks = 0;
+
+// Print "✓ label: yes", or "✗ label: NO" and count the failure
+void check(const std::string &label, bool passed) {
+    std::cout << (passed ? "✓ " : "✗ ") << label << ": " << (passed ? "yes" : "NO") << std::endl;
+    failedChecks += !passed;
+}
+
 int main() {
     std::cout << "=== Air Quality Data Manager Test ===" << std::endl;
     printSeparator();
@@ -126,6 +149,17 @@ int main() {
     std::cout << "✓ Indexed query (by pollutant): " << timer4a.getMicroseconds() 
               << " μs, found " << pm25Results.size() << " readings" << std::endl;
     
+    BenchmarkTimer timer4p;
+    timer4p.start();
+    const auto &pm25RowIds = manager.getRowIdsByPollutant("PM2.5");
+    double pm25Sum = 0.0;
+    for (RowId rowId : pm25RowIds) {
+        pm25Sum += manager.getReadingAt(rowId).getValue();
+    }
+    timer4p.stop();
+    std::cout << "✓ Posting list walk (by pollutant): " << timer4p.getMicroseconds() 
+              << " μs, visited " << pm25RowIds.size() << " readings (sum=" << pm25Sum << ")" << std::endl;
+    
     BenchmarkTimer timer4b;
     timer4b.start();
     auto aqiResults = manager.getReadingsByAQIRange(50, 100);
@@ -142,6 +176,804 @@ int main() {
     
     printSeparator();
     
+    
+    // ============================================================
+    // TEST LEVEL 5: Memory-mapped (zero-copy) loading
+    // ============================================================
+    std::cout << "\n[TEST 5] Loading ENTIRE DATASET via mmap..." << std::endl;
+    
+    AirQualityDataManager mappedManager;
+    mappedManager.setReadMode(CSVReadMode::MemoryMapped);
+    
+    BenchmarkTimer timer5("Memory-mapped load");
+    timer5.start();
+    mappedManager.loadFromDirectory(rootPath);
+    timer5.stop();
+    
+    std::cout << "\n✓ Loaded " << mappedManager.getReadingCount() << " readings in " 
+              << timer5.getMilliseconds() << " ms (stream: " 
+              << timer3.getMilliseconds() << " ms)" << std::endl;
+    check("Matches stream load",
+          mappedManager.getReadingCount() == manager.getReadingCount() &&
+          mappedManager.countReadingsAboveAQI(150) == hazardous &&
+          mappedManager.getAveragePollutantValue("PM2.5") == avgAll);
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 6: Byte-range parallel loading
+    // ============================================================
+    std::cout << "\n[TEST 6] Loading ENTIRE DATASET via byte ranges (4 threads)..." << std::endl;
+    
+    AirQualityDataManager rangeManager;
+    
+    BenchmarkTimer timer6("Byte-range load");
+    timer6.start();
+    rangeManager.loadFromDirectoryByteRanges(rootPath, 4);
+    timer6.stop();
+    
+    std::cout << "\n✓ Loaded " << rangeManager.getReadingCount() << " readings in " 
+              << timer6.getMilliseconds() << " ms" << std::endl;
+    check("Matches stream load",
+          rangeManager.getReadingCount() == manager.getReadingCount() &&
+          rangeManager.countReadingsAboveAQI(150) == hazardous &&
+          rangeManager.getAllDates() == manager.getAllDates());
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 7: Binary snapshot round trip
+    // ============================================================
+    std::cout << "\n[TEST 7] Writing and reloading a binary snapshot..." << std::endl;
+    
+    std::string snapshotPath = (std::filesystem::temp_directory_path() / "air_quality_test.aqsnap").string();
+    
+    BenchmarkTimer timer7a("Snapshot write");
+    timer7a.start();
+    bool saved = manager.saveSnapshot(snapshotPath);
+    timer7a.stop();
+    
+    AirQualityDataManager snapshotManager;
+    BenchmarkTimer timer7b("Snapshot load");
+    timer7b.start();
+    bool restored = saved && snapshotManager.loadSnapshot(snapshotPath);
+    timer7b.stop();
+    
+    std::cout << "✓ Wrote snapshot in " << timer7a.getMilliseconds() << " ms, reloaded " 
+              << snapshotManager.getReadingCount() << " readings in " 
+              << timer7b.getMilliseconds() << " ms" << std::endl;
+    check("Matches stream load",
+          restored && snapshotManager.getReadingCount() == manager.getReadingCount() &&
+          snapshotManager.countReadingsAboveAQI(150) == hazardous &&
+          snapshotManager.getAveragePollutantValue("PM2.5") == avgAll &&
+          snapshotManager.getRowIdsByPollutant("PM2.5") == pm25RowIds &&
+          snapshotManager.getAllDates() == manager.getAllDates() &&
+          snapshotManager.getTimeIndex().getRowIds() == manager.getTimeIndex().getRowIds());
+    
+    std::filesystem::remove(snapshotPath);
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 8: Time index range queries
+    // ============================================================
+    std::cout << "\n[TEST 8] Time range queries..." << std::endl;
+    
+    std::int64_t dayStart = 0;
+    std::int64_t dayEnd = 0;
+    CSVParser::parseEpochSeconds("2020-08-10", dayStart);
+    CSVParser::parseEpochSeconds("2020-08-11", dayEnd);
+    
+    BenchmarkTimer timer8("Time range query");
+    timer8.start();
+    auto dayReadings = manager.getReadingsByTimeRange(dayStart, dayEnd);
+    timer8.stop();
+    
+    // Same day through the string-keyed date index
+    size_t expectedDay = 0;
+    for (const auto &date : manager.getAllDates()) {
+        if (date.compare(0, 10, "2020-08-10") == 0) {
+            expectedDay += manager.getRowIdsByDate(date).size();
+        }
+    }
+    
+    const TimeIndex &timeIndex = manager.getTimeIndex();
+    size_t hourRows = 0;
+    for (const auto &bucket : timeIndex.getHourBuckets()) {
+        hourRows += bucket.end - bucket.begin;
+    }
+    
+    std::cout << "✓ 2020-08-10: " << dayReadings.size() << " readings in " 
+              << timer8.getMicroseconds() << " μs" << std::endl;
+    std::cout << "✓ Buckets: " << timeIndex.getHourBuckets().size() << " hours, " 
+              << timeIndex.getDayBuckets().size() << " days" << std::endl;
+    check("Matches date index",
+          dayReadings.size() == expectedDay && hourRows == timeIndex.size() &&
+          timeIndex.size() == static_cast<size_t>(manager.getReadingCount()));
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 9: AQI index
+    // ============================================================
+    std::cout << "\n[TEST 9] AQI index queries..." << std::endl;
+    
+    BenchmarkTimer timer9("AQI index count");
+    timer9.start();
+    int indexedUnhealthy = manager.countReadingsAboveAQI(100);
+    timer9.stop();
+    
+    // Same answers by scanning every row
+    int scannedUnhealthy = 0;
+    size_t scannedModerate = 0;
+    for (const auto &reading : manager.getAllReadings()) {
+        int aqi = reading.getAirQualityIndex();
+        if (aqi > 100) scannedUnhealthy++;
+        if (aqi >= 51 && aqi <= 100) scannedModerate++;
+    }
+    
+    auto moderate = manager.getReadingsByAQIRange(51, 100);
+    auto moderateParallel = manager.getReadingsByAQIRangeParallel(51, 100);
+    bool grouped = std::is_sorted(moderate.begin(), moderate.end(),
+        [](const AirQualityReading &a, const AirQualityReading &b) {
+            return a.getAirQualityIndex() < b.getAirQualityIndex();
+        });
+    
+    std::cout << "✓ AQI > 100: " << indexedUnhealthy << " readings in " 
+              << timer9.getMicroseconds() << " μs" << std::endl;
+    check("Matches full scan",
+          indexedUnhealthy == scannedUnhealthy && moderate.size() == scannedModerate &&
+          moderateParallel.size() == scannedModerate && grouped &&
+          manager.countReadingsAboveAQIParallel(100) == scannedUnhealthy);
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 10: Zone map pruning
+    // ============================================================
+    std::cout << "\n[TEST 10] Max aggregates over zone maps..." << std::endl;
+    
+    bool maxMatches = true;
+    for (const auto &pollutant : allPollutants) {
+        // Plain walk of the posting list for reference
+        double scannedMax = std::numeric_limits<double>::lowest();
+        for (RowId rowId : manager.getRowIdsByPollutant(pollutant)) {
+            scannedMax = std::max(scannedMax, manager.getReadingAt(rowId).getValue());
+        }
+        
+        maxMatches = maxMatches && manager.getMaxPollutantValue(pollutant) == scannedMax &&
+                     manager.getMaxPollutantValueParallel(pollutant) == scannedMax;
+    }
+    
+    BenchmarkTimer timer10("Zone-pruned max");
+    timer10.start();
+    double prunedMax = manager.getMaxPollutantValue("PM2.5");
+    timer10.stop();
+    
+    std::cout << "✓ Max PM2.5: " << prunedMax << " in " << timer10.getMicroseconds() << " μs" << std::endl;
+    check("Matches full scan", maxMatches);
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 11: Zero-copy result views
+    // ============================================================
+    std::cout << "\n[TEST 11] Result views..." << std::endl;
+    
+    BenchmarkTimer timer11a("View all readings");
+    timer11a.start();
+    ReadingView allView = manager.getAllReadings();
+    timer11a.stop();
+    
+    BenchmarkTimer timer11b("Materialize all readings");
+    timer11b.start();
+    std::vector<AirQualityReading> allCopy = allView.materialize();
+    timer11b.stop();
+    
+    // Views hand out the stored readings themselves
+    ReadingView pm25View = manager.getReadingsByPollutant("PM2.5");
+    bool sameObjects = pm25View.size() == pm25RowIds.size();
+    for (size_t i = 0; sameObjects && i < pm25View.size(); i++) {
+        sameObjects = &pm25View[i] == &manager.getReadingAt(pm25RowIds[i]);
+    }
+    
+    std::cout << "✓ View: " << allView.size() << " readings in " << timer11a.getMicroseconds() 
+              << " μs, materialize(): " << timer11b.getMilliseconds() << " ms" << std::endl;
+    check("Views reference the store",
+          sameObjects && allCopy.size() == allView.size() &&
+          (allCopy.empty() || allCopy.back().getSiteId() == allView[allView.size() - 1].getSiteId()));
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 12: Composed queries and the planner
+    // ============================================================
+    std::cout << "\n[TEST 12] Composed queries..." << std::endl;
+    
+    std::int64_t fireStart = 0;
+    std::int64_t fireEnd = 0;
+    CSVParser::parseEpochSeconds("2020-08-20", fireStart);
+    CSVParser::parseEpochSeconds("2020-08-21", fireEnd);
+    
+    std::vector<std::pair<std::string, AirQualityQuery>> queries = {
+        {"PM2.5, 2020-08-20, AQI > 150, near San Francisco",
+         AirQualityQuery().pollutant("PM2.5").timeRange(fireStart, fireEnd).aqiAbove(150)
+                          .boundingBox(37.2, 38.2, -123.0, -121.8)},
+        {"OZONE, AQI 51-100", AirQualityQuery().pollutant("OZONE").aqiRange(51, 100)},
+        {"Category 5+", AirQualityQuery().category(5, 6)},
+        {"Site 840060150007, 2020-08-10", AirQualityQuery().site("840060150007").timeRange(dayStart, dayEnd)},
+        {"Unknown pollutant", AirQualityQuery().pollutant("NOT-A-POLLUTANT")}
+    };
+    
+    bool queriesMatch = true;
+    for (const auto &named : queries) {
+        const AirQualityQuery &query = named.second;
+        
+        // Reference: test every reading
+        std::vector<RowId> expected;
+        for (RowId row = 0; row < static_cast<RowId>(manager.getReadingCount()); row++) {
+            if (query.matches(manager.getReadingAt(row))) {
+                expected.push_back(row);
+            }
+        }
+        
+        QueryPlan plan = manager.planQuery(query);
+        BenchmarkTimer timer12("Query");
+        timer12.start();
+        std::vector<RowId> rows = manager.selectRows(query);
+        timer12.stop();
+        
+        queriesMatch = queriesMatch && rows == expected && manager.selectRowsParallel(query) == expected;
+        std::cout << "✓ " << named.first << ": " << rows.size() << " readings in " 
+                  << timer12.getMicroseconds() << " μs via " << QueryPlan::accessName(plan.access) 
+                  << " (" << plan.candidateRows << " candidates)" << std::endl;
+    }
+    check("Matches full scan", queriesMatch);
+    
+    printSeparator();
+    
+    
+    // ============================================================
+    // TEST LEVEL 13: Spatial grid
+    // ============================================================
+    std::cout << "\n[TEST 13] Bounding box and nearest sites..." << std::endl;
+    
+    BenchmarkTimer timer13("Bounding box");
+    timer13.start();
+    ReadingView bayArea = manager.getReadingsInBoundingBox(37.2, 38.2, -123.0, -121.8);
+    timer13.stop();
+    
+    size_t expectedBayArea = 0;
+    for (const auto &reading : manager.getAllReadings()) {
+        if (reading.getLatitude() >= 37.2 && reading.getLatitude() <= 38.2 &&
+            reading.getLongitude() >= -123.0 && reading.getLongitude() <= -121.8) {
+            expectedBayArea++;
+        }
+    }
+    
+    // Reference: every site where it is first seen, nearest first
+    std::vector<std::pair<StringPool::Code, std::pair<double, double>>> siteLocations;
+    std::set<StringPool::Code> seenSites;
+    for (const auto &reading : manager.getAllReadings()) {
+        if (seenSites.insert(reading.getFullSiteIdCode()).second) {
+            siteLocations.push_back({reading.getFullSiteIdCode(), {reading.getLatitude(), reading.getLongitude()}});
+        }
+    }
+    
+    bool nearestMatch = true;
+    std::vector<std::pair<double, double>> points = {{37.7749, -122.4194}, {61.2, -149.9}, {0.0, 0.0}};
+    for (const auto &point : points) {
+        std::vector<std::pair<double, StringPool::Code>> expectedSites;
+        for (const auto &site : siteLocations) {
+            expectedSites.push_back({SpatialIndex::distanceKm(point.first, point.second, 
+                                                              site.second.first, site.second.second), site.first});
+        }
+        std::sort(expectedSites.begin(), expectedSites.end());
+        
+        auto nearest = manager.getNearestSites(point.first, point.second, 5);
+        nearestMatch = nearestMatch && nearest.size() == 5;
+        for (size_t i = 0; nearestMatch && i < nearest.size(); i++) {
+            nearestMatch = nearest[i].fullSiteId == expectedSites[i].second;
+        }
+    }
+    
+    BenchmarkTimer timer13b("Nearest sites");
+    timer13b.start();
+    auto nearestSF = manager.getNearestSites(37.7749, -122.4194, 5);
+    timer13b.stop();
+    
+    std::cout << "✓ Bay Area box: " << bayArea.size() << " readings in " << timer13.getMicroseconds() 
+              << " μs via " << QueryPlan::accessName(manager.planQuery(
+                     AirQualityQuery().boundingBox(37.2, 38.2, -123.0, -121.8)).access) << std::endl;
+    std::cout << "✓ 5 sites nearest San Francisco in " << timer13b.getMicroseconds() << " μs";
+    if (!nearestSF.empty()) {
+        std::cout << ", closest: " << StringPool::global().get(nearestSF.front().fullSiteId) << " (" 
+                  << nearestSF.front().distanceKm << " km)";
+    }
+    std::cout << std::endl;
+    check("Matches full scan", bayArea.size() == expectedBayArea && nearestMatch);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 14: Rollup cube
+    // ============================================================
+    std::cout << "\n[TEST 14] Pre-aggregated rollups..." << std::endl;
+    
+    // Reference answers from the posting lists, before the cube exists
+    std::map<std::string, std::pair<double, double>> scannedStats;
+    for (const auto &pollutant : allPollutants) {
+        scannedStats[pollutant] = {manager.getAveragePollutantValue(pollutant), 
+                                   manager.getMaxPollutantValue(pollutant)};
+    }
+    
+    BenchmarkTimer timer14("Build rollups");
+    timer14.start();
+    manager.setRollupsEnabled(true);
+    timer14.stop();
+    
+    const RollupCube &rollups = manager.getRollups();
+    bool rollupsMatch = true;
+    for (const auto &pollutant : allPollutants) {
+        StringPool::Code code = StringPool::global().find(pollutant);
+        const RollupCube::Stats total = rollups.getTotal(code);
+        
+        double scannedSumSquares = 0.0;
+        std::uint64_t timestamped = 0;
+        for (RowId rowId : manager.getRowIdsByPollutant(pollutant)) {
+            const AirQualityReading &reading = manager.getReadingAt(rowId);
+            scannedSumSquares += reading.getValue() * reading.getValue();
+            timestamped += reading.getTimestamp() != AirQualityReading::NO_TIMESTAMP;
+        }
+        double scannedMean = scannedStats[pollutant].first;
+        double scannedVariance = scannedSumSquares / total.count - scannedMean * scannedMean;
+        
+        std::uint64_t dailyCount = 0;
+        for (const auto &day : rollups.getDaily(code)) {
+            dailyCount += day.second.count;
+        }
+        std::uint64_t monthlyCount = 0;
+        for (const auto &month : rollups.getMonthly(code)) {
+            monthlyCount += month.second.count;
+        }
+        
+        rollupsMatch = rollupsMatch && total.count == manager.getRowIdsByPollutant(pollutant).size() &&
+                       manager.getAveragePollutantValue(pollutant) == scannedMean &&
+                       manager.getMaxPollutantValue(pollutant) == scannedStats[pollutant].second &&
+                       manager.getAveragePollutantValueParallel(pollutant) == scannedMean &&
+                       manager.getMaxPollutantValueParallel(pollutant) == scannedStats[pollutant].second &&
+                       std::abs(total.variance() - scannedVariance) <= 1e-6 * std::max(1.0, scannedVariance) &&
+                       dailyCount == timestamped && monthlyCount == timestamped;
+    }
+    
+    // One base cell against the same question asked as a query
+    for (const auto &reading : manager.getAllReadings()) {
+        if (reading.getTimestamp() == AirQualityReading::NO_TIMESTAMP) continue;
+        
+        std::int64_t hourStart = reading.getTimestamp() / TimeIndex::HOUR * TimeIndex::HOUR;
+        auto cellRows = manager.selectRows(AirQualityQuery()
+            .pollutant(reading.getPollutantType())
+            .site(StringPool::global().get(reading.getFullSiteIdCode()))
+            .timeRange(hourStart, hourStart + TimeIndex::HOUR));
+        rollupsMatch = rollupsMatch && rollups.getHour(reading.getPollutantTypeCode(), 
+                                                       reading.getFullSiteIdCode(), hourStart).count == cellRows.size();
+        break;
+    }
+    
+    BenchmarkTimer timer14b("Average from rollups");
+    timer14b.start();
+    double rolledUpAverage = manager.getAveragePollutantValue("PM2.5");
+    timer14b.stop();
+    
+    std::cout << "✓ Built " << rollups.getHourCellCount() << " pollutant/site/hour cells in " 
+              << timer14.getMilliseconds() << " ms" << std::endl;
+    std::cout << "✓ PM2.5 average from rollups: " << rolledUpAverage << " in " 
+              << timer14b.getMicroseconds() << " μs" << std::endl;
+    check("Matches full scan", rollupsMatch);
+    
+    manager.setRollupsEnabled(false);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 15: Incremental ingest
+    // ============================================================
+    std::cout << "\n[TEST 15] Incremental ingest and watch mode..." << std::endl;
+    
+    // A scratch root that receives hourly files the way the feed delivers them
+    fs::path ingestRoot = fs::temp_directory_path() / "air_quality_ingest_test";
+    fs::remove_all(ingestRoot);
+    fs::create_directories(ingestRoot / "20200818");
+    auto deliver = [&](const std::string &date, const std::string &hour) {
+        fs::create_directories(ingestRoot / date);
+        fs::copy_file(rootPath + "/" + date + "/" + date + "-" + hour + ".csv",
+                      ingestRoot / date / (date + "-" + hour + ".csv"), fs::copy_options::overwrite_existing);
+    };
+    
+    AirQualityDataManager ingested;
+    ingested.setRollupsEnabled(true);
+    deliver("20200818", "07");
+    deliver("20200818", "09");
+    size_t firstBatch = ingested.ingestNewFiles(ingestRoot.string());
+    
+    deliver("20200818", "11");
+    BenchmarkTimer timer15("Ingest one new hour");
+    timer15.start();
+    size_t secondBatch = ingested.ingestNewFiles(ingestRoot.string());
+    timer15.stop();
+    size_t idleBatch = ingested.ingestNewFiles(ingestRoot.string());
+    
+    auto rewrite07 = [&](const std::string &hour) {
+        fs::copy_file(rootPath + "/20200818/20200818-" + hour + ".csv", ingestRoot / "20200818" / "20200818-07.csv", 
+                      fs::copy_options::overwrite_existing);
+        fs::last_write_time(ingestRoot / "20200818" / "20200818-07.csv", fs::file_time_type::clock::now());
+    };
+    
+    // Rewrite the 07 hour with another hour's rows: its old rows must go
+    rewrite07("11");
+    size_t rewriteBatch = ingested.ingestNewFiles(ingestRoot.string());
+    
+    // 07 is now the last file loaded, like the current hour: a rewrite cuts
+    // its rows off the tail of every index instead of re-indexing
+    rewrite07("13");
+    BenchmarkTimer timer15b("Reload the tail hour");
+    timer15b.start();
+    size_t tailBatch = ingested.ingestNewFiles(ingestRoot.string());
+    timer15b.stop();
+    
+    AirQualityDataManager reference;
+    for (const char *hour : {"09", "11", "13"}) {
+        reference.loadFromCSV(rootPath + "/20200818/20200818-" + std::string(hour) + ".csv");
+    }
+    reference.setRollupsEnabled(true);
+    AirQualityQuery pm25 = AirQualityQuery().pollutant("PM2.5");
+    StringPool::Code pm25Code = StringPool::global().find("PM2.5");
+    RollupCube::Stats ingestedPM25 = ingested.getRollups().getTotal(pm25Code);
+    RollupCube::Stats referencePM25 = reference.getRollups().getTotal(pm25Code);
+    bool ingestMatches = firstBatch == 2 && secondBatch == 1 && idleBatch == 0 && rewriteBatch == 1 && tailBatch == 1 &&
+                         ingested.getReadingCount() == reference.getReadingCount() &&
+                         ingested.selectRows(pm25).size() == reference.selectRows(pm25).size() &&
+                         ingested.getTimeIndex().size() == reference.getTimeIndex().size() &&
+                         ingested.countReadingsAboveAQI(50) == reference.countReadingsAboveAQI(50) &&
+                         ingested.getReadingsInBoundingBox(30, 45, -125, -110).size() == 
+                             reference.getReadingsInBoundingBox(30, 45, -125, -110).size() &&
+                         ingested.getNearestSites(37.3, -121.9, 5).size() == reference.getNearestSites(37.3, -121.9, 5).size() &&
+                         ingestedPM25.count == referencePM25.count && ingestedPM25.max == referencePM25.max &&
+                         ingested.getRollups().getHourCellCount() == reference.getRollups().getHourCellCount();
+    
+    // Watch mode: a new date folder and file land while the watcher waits
+    size_t wakeups = 0;
+    size_t watchedFiles = 0;
+    ingested.watchDirectory(ingestRoot.string(), [&](size_t filesRead) {
+        watchedFiles += filesRead;
+        if (wakeups++ == 0) {
+            deliver("20200819", "01");
+        }
+        return watchedFiles < 1 && wakeups < 10;
+    }, 200);
+    reference.loadFromCSV(rootPath + "/20200819/20200819-01.csv");
+    ingestMatches = ingestMatches && watchedFiles == 1 && 
+                    ingested.getReadingCount() == reference.getReadingCount();
+    fs::remove_all(ingestRoot);
+    
+    std::cout << "✓ Ingested one new hour in " << timer15.getMilliseconds() << " ms, " 
+              << ingested.getManifest().size() << " files in manifest, watch picked up " 
+              << watchedFiles << " file after " << wakeups << " wakeups" << std::endl;
+    std::cout << "✓ Reloaded the rewritten tail hour in " << timer15b.getMilliseconds() << " ms" << std::endl;
+    check("Matches reloading from scratch", ingestMatches);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 16: Streaming aggregation
+    // ============================================================
+    std::cout << "\n[TEST 16] Streaming aggregation..." << std::endl;
+    
+    PollutantValueAggregator streamedValues;
+    AQIAboveCounter streamedUnhealthy(150);
+    StreamingAggregation stream;
+    stream.addAggregator(streamedValues);
+    stream.addAggregator(streamedUnhealthy);
+    
+    BenchmarkTimer timer16("Streaming aggregation");
+    timer16.start();
+    size_t streamedReadings = stream.run(rootPath, 4);
+    timer16.stop();
+    
+    bool streamMatches = streamedReadings == static_cast<size_t>(manager.getReadingCount()) &&
+                         streamedUnhealthy.getCount() == static_cast<size_t>(manager.countReadingsAboveAQI(150));
+    for (const auto &pollutant : allPollutants) {
+        RollupCube::Stats streamed = streamedValues.getStats(pollutant);
+        double average = manager.getAveragePollutantValue(pollutant);
+        // Threads add in a different order, so sums agree to rounding only
+        streamMatches = streamMatches && streamed.count == manager.getRowIdsByPollutant(pollutant).size() &&
+                        streamed.max == manager.getMaxPollutantValue(pollutant) &&
+                        std::abs(streamed.mean() - average) <= 1e-9 * std::max(1.0, std::abs(average));
+    }
+    
+    std::cout << "✓ Streamed " << streamedReadings << " readings in " << timer16.getMilliseconds() 
+              << " ms without storing them (PM2.5 average " << streamedValues.getStats("PM2.5").mean() << ")" << std::endl;
+    check("Matches loaded aggregates", streamMatches);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 17: Group-by aggregation
+    // ============================================================
+    std::cout << "\n[TEST 17] Group-by aggregation..." << std::endl;
+    
+    BenchmarkTimer timer17("Group by pollutant and site");
+    timer17.start();
+    auto bySite = manager.groupByParallel(GroupBy::Pollutant | GroupBy::Site);
+    timer17.stop();
+    
+    auto byPollutant = manager.groupByParallel(GroupBy::Pollutant);
+    bool groupsMatch = byPollutant.size() == allPollutants.size();
+    for (const auto &group : byPollutant) {
+        const std::string &pollutant = StringPool::global().get(group.key.pollutant);
+        double average = manager.getAveragePollutantValue(pollutant);
+        groupsMatch = groupsMatch && group.stats.count == manager.getRowIdsByPollutant(pollutant).size() &&
+                      group.stats.max == manager.getMaxPollutantValue(pollutant) &&
+                      std::abs(group.stats.mean() - average) <= 1e-9 * std::max(1.0, std::abs(average));
+    }
+    
+    // Finer groups must partition the rows, serial and parallel alike
+    std::set<std::pair<StringPool::Code, StringPool::Code>> pollutantSites;
+    std::uint64_t groupedRows = 0;
+    for (const auto &reading : manager.getAllReadings()) {
+        pollutantSites.insert({reading.getPollutantTypeCode(), reading.getFullSiteIdCode()});
+    }
+    for (const auto &group : bySite) {
+        groupedRows += group.stats.count;
+    }
+    auto serialBySite = manager.groupBy(GroupBy::Pollutant | GroupBy::Site);
+    groupsMatch = groupsMatch && bySite.size() == pollutantSites.size() && 
+                  groupedRows == static_cast<std::uint64_t>(manager.getReadingCount()) &&
+                  serialBySite.size() == bySite.size();
+    for (size_t i = 0; groupsMatch && i < bySite.size(); i++) {
+        groupsMatch = serialBySite[i].key == bySite[i].key && serialBySite[i].stats.count == bySite[i].stats.count &&
+                      serialBySite[i].stats.min == bySite[i].stats.min && serialBySite[i].stats.max == bySite[i].stats.max;
+    }
+    
+    std::cout << "✓ " << bySite.size() << " pollutant/site groups in " << timer17.getMilliseconds() << " ms" << std::endl;
+    check("Matches per-pollutant aggregates", groupsMatch);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 18: Work-stealing task loading
+    // ============================================================
+    std::cout << "\n[TEST 18] Loading ENTIRE DATASET as nested tasks (4 workers)..." << std::endl;
+    
+    ThreadPool pool(4);
+    AirQualityDataManager taskManager;
+    
+    BenchmarkTimer timer18("Task load");
+    timer18.start();
+    taskManager.loadFromDirectoryParallel(rootPath, pool);
+    timer18.stop();
+    
+    // Same pool, unrelated work: tasks that fan out and wait on their children
+    std::atomic<int> leaves{0};
+    TaskGroup fanOut(pool);
+    for (int i = 0; i < 8; i++) {
+        fanOut.run([&] {
+            TaskGroup children(pool);
+            for (int j = 0; j < 8; j++) {
+                children.run([&] { leaves++; });
+            }
+            children.wait();
+        });
+    }
+    fanOut.wait();
+    
+    bool tasksMatch = taskManager.getReadingCount() == rangeManager.getReadingCount() && leaves == 64;
+    for (int row = 0; tasksMatch && row < taskManager.getReadingCount(); row++) {
+        const AirQualityReading &a = taskManager.getReadingAt(row);
+        const AirQualityReading &b = rangeManager.getReadingAt(row);
+        tasksMatch = a.getFullSiteIdCode() == b.getFullSiteIdCode() && a.getTimestamp() == b.getTimestamp() &&
+                     a.getPollutantTypeCode() == b.getPollutantTypeCode() && a.getValue() == b.getValue();
+    }
+    
+    std::cout << "✓ Loaded " << taskManager.getReadingCount() << " readings in " 
+              << timer18.getMilliseconds() << " ms (byte ranges: " << timer6.getMilliseconds() << " ms)" << std::endl;
+    check("Matches byte-range load row for row", tasksMatch);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 19: NUMA-sharded storage
+    // ============================================================
+    std::cout << "\n[TEST 19] Loading ENTIRE DATASET into NUMA shards..." << std::endl;
+    
+    // Two shards even on a single-node machine, so the merges are exercised
+    std::vector<NumaTopology::Node> shardNodes = NumaTopology::nodes();
+    if (shardNodes.size() == 1) {
+        shardNodes.push_back(shardNodes.front());
+    }
+    AirQualityDataManagerSharded sharded(shardNodes);
+    
+    BenchmarkTimer timer19("Sharded load");
+    timer19.start();
+    sharded.loadFromDirectory(rootPath);
+    timer19.stop();
+    
+    bool shardsMatch = sharded.getReadingCount() == manager.getReadingCount() &&
+                       sharded.countReadingsAboveAQI(150) == hazardous &&
+                       sharded.getReadingsByAQIRange(51, 100).size() == manager.getReadingsByAQIRange(51, 100).size();
+    for (const auto &pollutant : allPollutants) {
+        double average = manager.getAveragePollutantValue(pollutant);
+        shardsMatch = shardsMatch && sharded.getMaxPollutantValue(pollutant) == manager.getMaxPollutantValue(pollutant) &&
+                      std::abs(sharded.getAveragePollutantValue(pollutant) - average) <= 1e-9 * std::max(1.0, std::abs(average));
+    }
+    auto shardedGroups = sharded.groupBy(GroupBy::Pollutant | GroupBy::Category);
+    auto singleGroups = manager.groupBy(GroupBy::Pollutant | GroupBy::Category);
+    shardsMatch = shardsMatch && shardedGroups.size() == singleGroups.size();
+    for (size_t i = 0; shardsMatch && i < shardedGroups.size(); i++) {
+        shardsMatch = shardedGroups[i].key == singleGroups[i].key &&
+                      shardedGroups[i].stats.count == singleGroups[i].stats.count;
+    }
+    
+    std::cout << "✓ Loaded " << sharded.getReadingCount() << " readings into " << sharded.getShardCount() 
+              << " shards (" << sharded.getShard(0).getReadingCount() << " in the first) in " 
+              << timer19.getMilliseconds() << " ms" << std::endl;
+    check("Matches single store", shardsMatch);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 20: Compressed columns
+    // ============================================================
+    std::cout << "\n[TEST 20] Loading ENTIRE DATASET into compressed columns..." << std::endl;
+    
+    CompressedColumns compressed;
+    
+    BenchmarkTimer timer20("Compressed load");
+    timer20.start();
+    compressed.loadFromDirectory(rootPath);
+    timer20.stop();
+    
+    auto compressedModerate = compressed.selectRowsByAQIRange(51, 100);
+    bool compressedMatch = compressed.getReadingCount() == manager.getReadingCount() &&
+                           compressed.countReadingsAboveAQI(150) == hazardous &&
+                           compressed.countReadingsAboveAQIParallel(150) == hazardous &&
+                           compressedModerate.size() == manager.getReadingsByAQIRange(51, 100).size() &&
+                           compressed.countReadingsByTimeRange(dayStart, dayEnd) == static_cast<int>(dayReadings.size());
+    size_t unhealthyRows = 0;
+    for (const auto &reading : manager.getAllReadings()) {
+        unhealthyRows += reading.getCategory() >= 4;
+    }
+    compressedMatch = compressedMatch && compressed.selectRowsByCategory(4, 6).size() == unhealthyRows;
+    
+    // Readings all fit 4 decimals, so feed the XOR fallback values that do
+    // not: thirds, random bit patterns, signed zeros and repeats, over full
+    // blocks and a partial tail, compared bit for bit
+    std::mt19937_64 bitSource(20);
+    std::vector<double> awkward;
+    for (size_t i = 0; i < 4 * ColumnEncoding::BLOCK_ROWS + 123; i++) {
+        std::uint64_t bits = bitSource();
+        double value;
+        switch (i / ColumnEncoding::BLOCK_ROWS) {
+            case 0: value = static_cast<double>(i) / 3; break;
+            case 1: std::memcpy(&value, &bits, sizeof value); break;
+            case 2: value = (i % 5 == 0) ? -0.0 : static_cast<double>(i % 100) / 10; break;
+            default: value = (i % 7 < 3) ? 1.0 / 3 : (bits % 2 ? -0.0 : 0.0); break;
+        }
+        awkward.push_back(value);
+    }
+    ColumnEncoding::DoubleColumn awkwardColumn;
+    for (double value : awkward) {
+        awkwardColumn.append(value);
+    }
+    std::vector<double> decoded(ColumnEncoding::BLOCK_ROWS);
+    size_t decodedRows = 0;
+    bool xorRoundTrip = awkwardColumn.getBlockCount() == 5;
+    for (size_t block = 0; xorRoundTrip && block < awkwardColumn.getBlockCount(); block++) {
+        size_t rows = awkwardColumn.decodeBlock(block, decoded.data());
+        xorRoundTrip = decodedRows + rows <= awkward.size() &&
+                       std::memcmp(decoded.data(), awkward.data() + decodedRows, rows * sizeof(double)) == 0;
+        decodedRows += rows;
+    }
+    xorRoundTrip = xorRoundTrip && decodedRows == awkward.size();
+    for (const auto &pollutant : allPollutants) {
+        double average = manager.getAveragePollutantValue(pollutant);
+        compressedMatch = compressedMatch &&
+                          compressed.getMaxPollutantValue(pollutant) == manager.getMaxPollutantValue(pollutant) &&
+                          std::abs(compressed.getAveragePollutantValue(pollutant) - average) <= 1e-9 * std::max(1.0, std::abs(average)) &&
+                          std::abs(compressed.getAveragePollutantValueParallel(pollutant) - average) <= 1e-9 * std::max(1.0, std::abs(average));
+    }
+    
+    std::cout << "✓ Loaded " << compressed.getReadingCount() << " readings in " << timer20.getMilliseconds()
+              << " ms: " << compressed.memoryBytes() / 1024 << " KB encoded vs "
+              << compressed.plainBytes() / 1024 << " KB plain" << std::endl;
+    check("Matches row store", compressedMatch);
+    check("Non-decimal doubles round-trip bit for bit", xorRoundTrip);
+    
+    printSeparator();
+    
+    // ============================================================
+    // TEST LEVEL 21: Per-site window functions
+    // ============================================================
+    std::cout << "\n[TEST 21] Rolling 8h/24h windows and EMA per site..." << std::endl;
+    
+    BenchmarkTimer timer21a("Build site series");
+    timer21a.start();
+    TimeSeries pm25Series(manager, "PM2.5");
+    timer21a.stop();
+    
+    BenchmarkTimer timer21b("Rolling 8h mean, 1 thread");
+    timer21b.start();
+    auto mean8Serial = pm25Series.rollingMean(8 * TimeSeries::HOUR_SECONDS, 1);
+    timer21b.stop();
+    
+    BenchmarkTimer timer21c("Rolling 8h mean, 4 threads");
+    timer21c.start();
+    auto mean8 = pm25Series.rollingMean(8 * TimeSeries::HOUR_SECONDS);
+    timer21c.stop();
+    
+    auto max24 = pm25Series.rollingMax(24 * TimeSeries::HOUR_SECONDS);
+    auto min24 = pm25Series.rollingMin(24 * TimeSeries::HOUR_SECONDS);
+    auto ema = pm25Series.exponentialMovingAverage(0.25);
+    
+    // Every site in order, and every window against a backwards rescan
+    bool seriesMatch = pm25Series.getPointCount() == manager.getRowIdsByPollutant("PM2.5").size() &&
+                       mean8.size() == pm25Series.getSiteCount();
+    for (size_t s = 0; seriesMatch && s < pm25Series.getSiteCount(); s++) {
+        const auto &points = pm25Series.getSeries()[s].points;
+        double expectedEMA = points.front().value;
+        
+        for (size_t i = 0; i < points.size(); i++) {
+            double sum = 0.0;
+            size_t count = 0;
+            double high = std::numeric_limits<double>::lowest();
+            double low = std::numeric_limits<double>::max();
+            
+            for (size_t j = i + 1; j-- > 0 && points[j].timestamp > points[i].timestamp - 24 * TimeSeries::HOUR_SECONDS;) {
+                if (points[j].timestamp > points[i].timestamp - 8 * TimeSeries::HOUR_SECONDS) {
+                    sum += points[j].value;
+                    count++;
+                }
+                high = std::max(high, points[j].value);
+                low = std::min(low, points[j].value);
+            }
+            expectedEMA = 0.25 * points[i].value + 0.75 * expectedEMA;
+            
+            seriesMatch = seriesMatch && (i == 0 || points[i - 1].timestamp <= points[i].timestamp) &&
+                          std::abs(mean8[s].points[i].value - sum / count) <= 1e-9 * std::max(1.0, std::abs(sum / count)) &&
+                          mean8Serial[s].points[i].value == mean8[s].points[i].value &&
+                          max24[s].points[i].value == high && min24[s].points[i].value == low &&
+                          std::abs(ema[s].points[i].value - expectedEMA) <= 1e-9 * std::max(1.0, std::abs(expectedEMA));
+        }
+    }
+    
+    const TimeSeries::Series *firstSite = pm25Series.getSiteCount() ? &pm25Series.getSeries().front() : nullptr;
+    seriesMatch = seriesMatch && firstSite &&
+                  pm25Series.findSite(StringPool::global().get(firstSite->site)) == firstSite;
+    
+    // Windows of no length have nothing to compute over
+    seriesMatch = seriesMatch && pm25Series.rollingMean(0).empty() && pm25Series.rollingMax(-TimeSeries::HOUR_SECONDS).empty() &&
+                  pm25Series.rollingMin(0).empty();
+    
+    std::cout << "✓ " << pm25Series.getPointCount() << " PM2.5 points over " << pm25Series.getSiteCount()
+              << " sites, grouped and sorted in " << timer21a.getMilliseconds() << " ms" << std::endl;
+    std::cout << "✓ Rolling 8h mean: " << timer21b.getMicroseconds() << " μs on 1 thread, "
+              << timer21c.getMicroseconds() << " μs on 4" << std::endl;
+    check("Matches window rescan", seriesMatch);
+    
+    printSeparator();
+    
+    if (failedChecks > 0) {
+        std::cout << "\n=== " << failedChecks << " check(s) FAILED ===" << std::endl;
+        return 1;
+    }
+    
     std::cout << "\n=== All tests completed successfully! ===" << std::endl;
     
     return 0;
@@ -0,0 +1,149 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <omp.h>
+#include "AirQualityDataManager.hpp"
+#include "AirQualityDataManagerSharded.hpp"
+#include "BenchMarkTimer.hpp"
+
+namespace {
+
+const int REPEATS = 5;
+
+void printSeparator() {
+    std::cout << "================================================" << std::endl;
+}
+
+// Sum every value of manager's readings with the calling thread's OpenMP team
+double scanValues(const AirQualityDataManager &manager) {
+    ReadingView all = manager.getAllReadings();
+    double sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum)
+    for (size_t i = 0; i < all.size(); i++) {
+        sum += all[i].getValue();
+    }
+    return sum;
+}
+
+void printBandwidth(const std::string &label, size_t bytes, long long micros) {
+    std::cout << "  " << std::left << std::setw(28) << label << std::right
+              << std::setw(8) << micros << " μs  " << std::fixed << std::setprecision(2)
+              << (micros > 0 ? bytes / (micros * 1000.0) : 0.0) << " GB/s" << std::endl;
+}
+
+// Best of REPEATS runs of scan
+template <typename Scan>
+long long bestMicros(Scan scan) {
+    long long best = -1;
+    for (int run = 0; run < REPEATS; run++) {
+        BenchmarkTimer timer;
+        timer.start();
+        scan();
+        timer.stop();
+        if (best < 0 || timer.getMicroseconds() < best) {
+            best = timer.getMicroseconds();
+        }
+    }
+    return best;
+}
+
+}
+
+int main() {
+    std::cout << "\n";
+    printSeparator();
+    std::cout << "  NUMA-LOCAL vs INTERLEAVED SCAN BANDWIDTH" << std::endl;
+    printSeparator();
+
+    std::string dataRoot = "../../../data/2020-fire/data";
+
+    std::vector<NumaTopology::Node> nodes = NumaTopology::nodes();
+    std::cout << "\nNUMA nodes: " << nodes.size() << std::endl;
+    for (const auto &node : nodes) {
+        std::cout << "  node " << node.id << ": " << node.cpus.size() << " CPUs" << std::endl;
+    }
+
+    // A single node still gets two shards, so the code paths are exercised;
+    // local and remote then read the same memory and should match
+    if (nodes.size() == 1) {
+        std::cout << "Only one node: splitting it into 2 shards, expect no local/remote gap" << std::endl;
+        nodes.push_back(nodes.front());
+    }
+
+    AirQualityDataManagerSharded sharded(nodes);
+    BenchmarkTimer shardedLoad;
+    shardedLoad.start();
+    sharded.loadFromDirectory(dataRoot);
+    shardedLoad.stop();
+
+    // The single vector's pages are first touched by this thread when it is
+    // sized, so interleaving this thread spreads them over every node
+    bool interleavedPages = NumaTopology::interleaveCurrentThread(nodes);
+    if (!interleavedPages) {
+        std::cout << "Interleaving not supported: the single vector stays on one node" << std::endl;
+    }
+
+    AirQualityDataManager single;
+    BenchmarkTimer singleLoad;
+    singleLoad.start();
+    single.loadFromDirectoryByteRanges(dataRoot, omp_get_max_threads());
+    singleLoad.stop();
+
+    if (interleavedPages) {
+        NumaTopology::resetCurrentThreadMemory();
+    }
+
+    size_t bytes = static_cast<size_t>(single.getReadingCount()) * sizeof(AirQualityReading);
+    std::cout << "\nLoaded " << sharded.getReadingCount() << " readings (" << bytes / (1024 * 1024)
+              << " MB of readings) - sharded: " << shardedLoad.getMilliseconds()
+              << " ms, single vector: " << singleLoad.getMilliseconds() << " ms" << std::endl;
+
+    std::cout << "\n[SCAN ALL VALUES, best of " << REPEATS << "]" << std::endl;
+
+    // Every node scans the shard it loaded
+    std::vector<double> sums(sharded.getShardCount());
+    long long local = bestMicros([&] {
+        sharded.runOnNodes([&](size_t shard) {
+            sums[shard] = scanValues(sharded.getShard(shard));
+        });
+    });
+    printBandwidth("Node-local shards", bytes, local);
+
+    // Every node scans its neighbour's shard: all traffic crosses nodes
+    long long remote = bestMicros([&] {
+        sharded.runOnNodes([&](size_t shard) {
+            sums[shard] = scanValues(sharded.getShard((shard + 1) % sharded.getShardCount()));
+        });
+    });
+    printBandwidth("Remote shards", bytes, remote);
+
+    // One vector, pages round-robin over the nodes (or all on this one)
+    long long interleaved = bestMicros([&] {
+        sums[0] = scanValues(single);
+    });
+    printBandwidth(interleavedPages ? "Interleaved, all threads" : "Single node, all threads",
+                   bytes, interleaved);
+
+    std::cout << "\n[QUERIES]" << std::endl;
+
+    BenchmarkTimer shardedRange;
+    shardedRange.start();
+    auto shardedModerate = sharded.getReadingsByAQIRange(51, 100);
+    shardedRange.stop();
+
+    BenchmarkTimer singleRange;
+    singleRange.start();
+    auto singleModerate = single.getReadingsByAQIRangeParallel(51, 100);
+    singleRange.stop();
+
+    std::cout << "  AQI 51-100 sharded: " << shardedRange.getMicroseconds() << " μs ("
+              << shardedModerate.size() << " readings), single: " << singleRange.getMicroseconds()
+              << " μs (" << singleModerate.size() << " readings)" << std::endl;
+
+    std::cout << "\n";
+    printSeparator();
+    std::cout << "✓ NUMA benchmark completed!" << std::endl;
+
+    return 0;
+}
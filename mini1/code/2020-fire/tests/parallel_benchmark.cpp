@@ -1,6 +1,8 @@
 #include <iostream>
 #include <iomanip>
 #include "AirQualityDataManager.hpp"
+#include "AirQualityDataManagerColumnar.hpp"
+#include "StreamingAggregation.hpp"
 #include "BenchMarkTimer.hpp"
 
 void printSeparator() {
@@ -47,6 +49,27 @@ void compareLoadingPerformance(const std::string &dataRoot) {
         std::cout << "  Speedup: " << std::fixed << std::setprecision(2) 
                   << speedup << "x" << std::endl;
     }
+    
+    // Byte-range loading: files are split, so every thread gets work even
+    // when there are fewer date folders than threads
+    for (int threads : threadCounts) {
+        AirQualityDataManager rangeManager;
+        BenchmarkTimer rangeTimer;
+        
+        std::cout << "\n[BYTE RANGES - " << threads << " threads] Loading full dataset..." << std::endl;
+        rangeTimer.start();
+        rangeManager.loadFromDirectoryByteRanges(dataRoot, threads);
+        rangeTimer.stop();
+        
+        int rangeCount = rangeManager.getReadingCount();
+        long long rangeTime = rangeTimer.getMilliseconds();
+        double speedup = (double)serialTime / rangeTime;
+        
+        std::cout << "✓ Byte ranges (" << threads << "): " << rangeCount 
+                  << " readings in " << rangeTime << " ms" << std::endl;
+        std::cout << "  Speedup: " << std::fixed << std::setprecision(2) 
+                  << speedup << "x" << std::endl;
+    }
 }
 
 void compareQueryPerformance(AirQualityDataManager &manager) {
@@ -125,6 +148,147 @@ void compareAggregationPerformance(AirQualityDataManager &manager) {
     std::cout << "  Speedup: " << std::fixed << std::setprecision(2)
               << ((double)serialCountTimer.getMicroseconds() / parallelCountTimer.getMicroseconds()) 
               << "x" << std::endl;
+    
+    // Every pollutant: one parallel average per type vs one group-by scan
+    BenchmarkTimer perPollutantTimer;
+    perPollutantTimer.start();
+    for (const auto &type : manager.getAllPollutantTypes()) {
+        manager.getAveragePollutantValueParallel(type);
+        manager.getMaxPollutantValueParallel(type);
+    }
+    perPollutantTimer.stop();
+    
+    BenchmarkTimer groupByTimer;
+    groupByTimer.start();
+    auto groups = manager.groupByParallel(GroupBy::Pollutant);
+    groupByTimer.stop();
+    
+    std::cout << "\n[AVERAGE + MAX OF EVERY POLLUTANT]" << std::endl;
+    std::cout << "  Per pollutant: " << perPollutantTimer.getMicroseconds() << " μs" << std::endl;
+    std::cout << "  Group-by: " << groupByTimer.getMicroseconds() 
+              << " μs (" << groups.size() << " groups)" << std::endl;
+    std::cout << "  Speedup: " << std::fixed << std::setprecision(2)
+              << ((double)perPollutantTimer.getMicroseconds() / groupByTimer.getMicroseconds()) 
+              << "x" << std::endl;
+}
+
+void compareStorageLayouts(AirQualityDataManager &rowManager, const std::string &dataRoot) {
+    std::cout << "\n=== ROW (AoS) vs COLUMNAR (SoA) SCAN COMPARISON ===" << std::endl;
+    printSeparator();
+    
+    AirQualityDataManagerColumnar columnManager;
+    BenchmarkTimer loadTimer;
+    loadTimer.start();
+    columnManager.loadFromDirectory(dataRoot);
+    loadTimer.stop();
+    
+    std::cout << "\n[COLUMNAR] Loaded " << columnManager.getReadingCount() 
+              << " readings in " << loadTimer.getMilliseconds() << " ms" << std::endl;
+    
+    // Count scan: touches only the AQI field
+    BenchmarkTimer rowCountTimer;
+    rowCountTimer.start();
+    int rowCount = rowManager.countReadingsAboveAQI(100);
+    rowCountTimer.stop();
+    
+    BenchmarkTimer columnCountTimer;
+    columnCountTimer.start();
+    int columnCount = columnManager.countReadingsAboveAQI(100);
+    columnCountTimer.stop();
+    
+    std::cout << "\n[COUNT AQI > 100]" << std::endl;
+    std::cout << "  Row: " << rowCountTimer.getMicroseconds() 
+              << " μs (count=" << rowCount << ")" << std::endl;
+    std::cout << "  Columnar: " << columnCountTimer.getMicroseconds() 
+              << " μs (count=" << columnCount << ")" << std::endl;
+    std::cout << "  Speedup: " << std::fixed << std::setprecision(2)
+              << ((double)rowCountTimer.getMicroseconds() / columnCountTimer.getMicroseconds()) 
+              << "x" << std::endl;
+    
+    // Parallel count scan
+    BenchmarkTimer rowParallelTimer;
+    rowParallelTimer.start();
+    int rowParallelCount = rowManager.countReadingsAboveAQIParallel(100);
+    rowParallelTimer.stop();
+    
+    BenchmarkTimer columnParallelTimer;
+    columnParallelTimer.start();
+    int columnParallelCount = columnManager.countReadingsAboveAQIParallel(100);
+    columnParallelTimer.stop();
+    
+    std::cout << "\n[PARALLEL COUNT AQI > 100]" << std::endl;
+    std::cout << "  Row: " << rowParallelTimer.getMicroseconds() 
+              << " μs (count=" << rowParallelCount << ")" << std::endl;
+    std::cout << "  Columnar: " << columnParallelTimer.getMicroseconds() 
+              << " μs (count=" << columnParallelCount << ")" << std::endl;
+    
+    // Range query: scan is columnar, matches are rebuilt into readings
+    BenchmarkTimer rowRangeTimer;
+    rowRangeTimer.start();
+    auto rowResults = rowManager.getReadingsByAQIRange(50, 100);
+    rowRangeTimer.stop();
+    
+    BenchmarkTimer columnRangeTimer;
+    columnRangeTimer.start();
+    auto columnResults = columnManager.getReadingsByAQIRange(50, 100);
+    columnRangeTimer.stop();
+    
+    std::cout << "\n[RANGE QUERY AQI 50-100]" << std::endl;
+    std::cout << "  Row: " << rowRangeTimer.getMicroseconds() 
+              << " μs (results=" << rowResults.size() << ")" << std::endl;
+    std::cout << "  Columnar: " << columnRangeTimer.getMicroseconds() 
+              << " μs (results=" << columnResults.size() << ")" << std::endl;
+    
+    // Aggregation over the pollutant index
+    BenchmarkTimer rowAvgTimer;
+    rowAvgTimer.start();
+    double rowAvg = rowManager.getAveragePollutantValue("PM2.5");
+    rowAvgTimer.stop();
+    
+    BenchmarkTimer columnAvgTimer;
+    columnAvgTimer.start();
+    double columnAvg = columnManager.getAveragePollutantValue("PM2.5");
+    columnAvgTimer.stop();
+    
+    std::cout << "\n[AVERAGE PM2.5]" << std::endl;
+    std::cout << "  Row: " << rowAvgTimer.getMicroseconds() 
+              << " μs (result=" << rowAvg << ")" << std::endl;
+    std::cout << "  Columnar: " << columnAvgTimer.getMicroseconds() 
+              << " μs (result=" << columnAvg << ")" << std::endl;
+}
+
+void compareStreamingAggregation(AirQualityDataManager &manager, const std::string &dataRoot) {
+    std::cout << "\n=== LOAD-THEN-AGGREGATE vs STREAMING AGGREGATION ===" << std::endl;
+    printSeparator();
+    
+    // Loading is measured in compareLoadingPerformance; here only the report
+    BenchmarkTimer loadedTimer;
+    loadedTimer.start();
+    double loadedAvg = manager.getAveragePollutantValue("PM2.5");
+    int loadedCount = manager.countReadingsAboveAQI(100);
+    loadedTimer.stop();
+    
+    std::cout << "\n[LOADED] Report over " << manager.getReadingCount() << " stored readings: " 
+              << loadedTimer.getMicroseconds() << " μs (avg PM2.5=" << loadedAvg 
+              << ", AQI > 100: " << loadedCount << ")" << std::endl;
+    
+    std::vector<int> threadCounts = {1, 2, 4, 8};
+    for (int threads : threadCounts) {
+        PollutantValueAggregator values;
+        AQIAboveCounter unhealthy(100);
+        StreamingAggregation stream;
+        stream.addAggregator(values);
+        stream.addAggregator(unhealthy);
+        
+        BenchmarkTimer streamTimer;
+        streamTimer.start();
+        size_t seen = stream.run(dataRoot, threads);
+        streamTimer.stop();
+        
+        std::cout << "\n[STREAMING - " << threads << " threads] " << seen << " readings, none stored: " 
+                  << streamTimer.getMilliseconds() << " ms (avg PM2.5=" << values.getStats("PM2.5").mean() 
+                  << ", AQI > 100: " << unhealthy.getCount() << ")" << std::endl;
+    }
 }
 
 int main() {
@@ -149,6 +313,12 @@ int main() {
     // Test 3: Aggregation performance
     compareAggregationPerformance(manager);
     
+    // Test 4: Row vs columnar storage
+    compareStorageLayouts(manager, dataRoot);
+    
+    // Test 5: Aggregates without storing readings
+    compareStreamingAggregation(manager, dataRoot);
+    
     std::cout << "\n";
     printSeparator();
     std::cout << "✓ All comparisons completed!" << std::endl;
@@ -0,0 +1,66 @@
+#include "Arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+Arena::Arena(size_t chunkBytes)
+    : chunks(nullptr), cursor(nullptr), limit(nullptr),
+      chunkBytes(std::max<size_t>(chunkBytes, 256)), chunkCount(0), bytesUsed(0) {}
+
+Arena::~Arena() {
+    release();
+}
+
+Arena::Chunk *Arena::newChunk(size_t size) {
+    void *memory = ::operator new(sizeof(Chunk) + size);
+    Chunk *chunk = static_cast<Chunk *>(memory);
+    chunk->size = size;
+    chunkCount++;
+    return chunk;
+}
+
+void *Arena::allocate(size_t bytes, size_t alignment) {
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(cursor);
+    std::uintptr_t aligned = (address + alignment - 1) & ~(std::uintptr_t(alignment) - 1);
+
+    if (cursor && aligned + bytes <= reinterpret_cast<std::uintptr_t>(limit)) {
+        cursor = reinterpret_cast<char *>(aligned + bytes);
+        bytesUsed += bytes;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    // Worst-case padding, so the aligned block always fits
+    size_t needed = bytes + alignment;
+
+    // Large blocks get a chunk of their own behind the current one, so the
+    // space left in the current chunk is not abandoned
+    if (needed > chunkBytes / 4 && chunks) {
+        Chunk *chunk = newChunk(needed);
+        chunk->next = chunks->next;
+        chunks->next = chunk;
+
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(chunk + 1);
+        bytesUsed += bytes;
+        return reinterpret_cast<void *>((start + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+    }
+
+    Chunk *chunk = newChunk(std::max(chunkBytes, needed));
+    chunk->next = chunks;
+    chunks = chunk;
+    cursor = reinterpret_cast<char *>(chunk + 1);
+    limit = cursor + chunk->size;
+
+    return allocate(bytes, alignment);
+}
+
+void Arena::release() {
+    while (chunks) {
+        Chunk *next = chunks->next;
+        ::operator delete(chunks);
+        chunks = next;
+    }
+    cursor = nullptr;
+    limit = nullptr;
+    chunkCount = 0;
+    bytesUsed = 0;
+}
@@ -0,0 +1,101 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * Arena - Monotonic (bump-pointer) allocator owning a list of chunks
+ *
+ * allocate() moves a pointer forward inside the current chunk and only
+ * goes to the heap when a chunk fills up, so loading many small objects
+ * costs a handful of real allocations. Nothing is freed individually:
+ * release() drops every chunk at once, O(chunks) instead of O(objects).
+ * Not thread-safe; give each loader its own arena.
+ */
+class Arena {
+private:
+    struct Chunk {
+        Chunk *next;
+        size_t size;        // usable bytes after the header
+    };
+
+    Chunk *chunks;
+    char *cursor;
+    char *limit;
+    size_t chunkBytes;
+    size_t chunkCount;
+    size_t bytesUsed;
+
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    explicit Arena(size_t chunkBytes = DEFAULT_CHUNK_BYTES);
+    ~Arena();
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    // Free every chunk; everything allocated from the arena becomes invalid
+    void release();
+
+    size_t getChunkCount() const { return chunkCount; }
+    size_t getBytesUsed() const { return bytesUsed; }
+
+private:
+    Chunk *newChunk(size_t size);
+};
+
+/**
+ * ArenaAllocator - Standard allocator drawing from an Arena
+ *
+ * deallocate() is a no-op; memory returns when the arena is released, so
+ * containers using it must not outlive their arena. A default-constructed
+ * allocator has no arena and uses the heap, so types that use it still
+ * work without one. Containers only share storage with equal allocators,
+ * i.e. the same arena. Copy-constructed containers go to the heap, so a
+ * copy of arena-backed data survives release() and never touches an
+ * arena its owner may be using.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator() noexcept = default;
+    ArenaAllocator(Arena *arena) noexcept : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : arena(other.getArena()) {}
+
+    T *allocate(size_t count) {
+        if (!arena) {
+            return std::allocator<T>().allocate(count);
+        }
+        return static_cast<T *>(arena->allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *pointer, size_t count) noexcept {
+        if (!arena) {
+            std::allocator<T>().deallocate(pointer, count);
+        }
+    }
+
+    // Copies of a container do not inherit its arena
+    ArenaAllocator select_on_container_copy_construction() const { return ArenaAllocator(); }
+
+    Arena *getArena() const noexcept { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U> &other) const noexcept { return arena == other.getArena(); }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const noexcept { return arena != other.getArena(); }
+
+private:
+    Arena *arena = nullptr;
+};
+
+#endif // ARENA_HPP
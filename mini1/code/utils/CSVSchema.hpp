@@ -0,0 +1,171 @@
+#ifndef CSV_SCHEMA_HPP
+#define CSV_SCHEMA_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "CSVParser.hpp"
+
+/**
+ * CSVSchema - Compile-time description of a CSV row layout
+ *
+ * A schema lists, for each CSV column, which member of a destination struct
+ * it decodes into; the member's type picks the parser. The generated decode()
+ * is a straight sequence of std::from_chars calls with no exceptions: every
+ * column is attempted, failures are tallied per CSV column, and the results
+ * are combined without short-circuiting.
+ *
+ *   struct Point { double x; double y; std::string_view label; };
+ *   using PointSchema = CSVSchema<Point,
+ *       Column<0, &Point::x>, Column<1, &Point::y>, Column<2, &Point::label>>;
+ */
+
+// Required columns reject the row on a bad value. Optional columns treat an
+// empty or ".." field as missing (destination left untouched) and never
+// reject the row, although unparsable values are still counted.
+enum class ColumnPresence {
+    Required,
+    Optional
+};
+
+// How a field is parsed into a destination of type T
+template <typename T>
+struct FieldDecoder;
+
+template <>
+struct FieldDecoder<double> {
+    static bool decode(std::string_view field, double &value) {
+        return CSVParser::parseDouble(CSVParser::trimView(field), value);
+    }
+};
+
+template <>
+struct FieldDecoder<int> {
+    static bool decode(std::string_view field, int &value) {
+        return CSVParser::parseInt(CSVParser::trimView(field), value);
+    }
+};
+
+template <>
+struct FieldDecoder<long> {
+    static bool decode(std::string_view field, long &value) {
+        return CSVParser::parseLong(CSVParser::trimView(field), value);
+    }
+};
+
+template <>
+struct FieldDecoder<std::string_view> {
+    static bool decode(std::string_view field, std::string_view &value) {
+        value = field;
+        return true;
+    }
+};
+
+template <>
+struct FieldDecoder<std::string> {
+    static bool decode(std::string_view field, std::string &value) {
+        value.assign(field);
+        return true;
+    }
+};
+
+// ISO-8601 date/time column decoded to UTC seconds since the epoch; use a
+// second Column on the same index to keep the raw string as well
+struct EpochSeconds {
+    std::int64_t value = 0;
+};
+
+template <>
+struct FieldDecoder<EpochSeconds> {
+    static bool decode(std::string_view field, EpochSeconds &value) {
+        return CSVParser::parseEpochSeconds(CSVParser::trimView(field), value.value);
+    }
+};
+
+namespace csv_schema_detail {
+
+inline bool isMissing(std::string_view field) {
+    field = CSVParser::trimView(field);
+    return field.empty() || field == "..";
+}
+
+template <ColumnPresence Presence, typename T>
+bool decodeField(std::string_view field, T &value, size_t &errorCount) {
+    if constexpr (Presence == ColumnPresence::Optional) {
+        if (isMissing(field)) {
+            return true;
+        }
+    }
+    bool ok = FieldDecoder<T>::decode(field, value);
+    errorCount += !ok;
+    return ok || Presence == ColumnPresence::Optional;
+}
+
+}
+
+// CSV column Index decodes into Row::*Member
+template <size_t Index, auto Member, ColumnPresence Presence = ColumnPresence::Required>
+struct Column {
+    static constexpr size_t END = Index + 1;
+    
+    template <typename Row, size_t N>
+    static bool decode(const std::vector<std::string_view> &fields, Row &row,
+                       std::array<size_t, N> &errors) {
+        return csv_schema_detail::decodeField<Presence>(fields[Index], row.*Member, errors[Index]);
+    }
+};
+
+// CSV columns First .. First+Count-1 decode into the array Row::*Member
+template <size_t First, size_t Count, auto Member, ColumnPresence Presence = ColumnPresence::Required>
+struct ColumnRange {
+    static constexpr size_t END = First + Count;
+    
+    template <typename Row, size_t N>
+    static bool decode(const std::vector<std::string_view> &fields, Row &row,
+                       std::array<size_t, N> &errors) {
+        bool ok = true;
+        for (size_t i = 0; i < Count; i++) {
+            ok &= csv_schema_detail::decodeField<Presence>(fields[First + i], (row.*Member)[i],
+                                                            errors[First + i]);
+        }
+        return ok;
+    }
+};
+
+template <typename Row, typename... Columns>
+class CSVSchema {
+public:
+    // Number of CSV fields the schema reads (highest column + 1)
+    static constexpr size_t FIELD_COUNT = std::max({Columns::END...});
+    
+    // Failed values per CSV column
+    using ErrorCounts = std::array<size_t, FIELD_COUNT>;
+    
+    /**
+     * Decode tokenized fields into row
+     *
+     * @return false if there are too few fields or a required column is bad
+     */
+    static bool decode(const std::vector<std::string_view> &fields, Row &row, ErrorCounts &errors) {
+        if (fields.size() < FIELD_COUNT) {
+            return false;
+        }
+        return (Columns::decode(fields, row, errors) & ...);
+    }
+    
+    // Total failed values across all columns
+    static size_t totalErrors(const ErrorCounts &errors) {
+        size_t total = 0;
+        for (size_t count : errors) {
+            total += count;
+        }
+        return total;
+    }
+};
+
+#endif // CSV_SCHEMA_HPP
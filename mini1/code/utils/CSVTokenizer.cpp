@@ -0,0 +1,161 @@
+#include "CSVTokenizer.hpp"
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSV_TOKENIZER_X86 1
+#endif
+
+namespace {
+
+const size_t BLOCK_SIZE = 64;
+
+// Bitmasks of the structural characters in one 64-byte block
+struct BlockMasks {
+    uint64_t comma;
+    uint64_t quote;
+    uint64_t newline;
+};
+
+// Bit i is set if an odd number of quote bits are set at or below i
+inline uint64_t prefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+BlockMasks classifyScalar(const char *block) {
+    BlockMasks masks = {0, 0, 0};
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        uint64_t bit = uint64_t(1) << i;
+        char c = block[i];
+        if (c == ',') masks.comma |= bit;
+        else if (c == '"') masks.quote |= bit;
+        else if (c == '\n') masks.newline |= bit;
+    }
+    return masks;
+}
+
+#ifdef CSV_TOKENIZER_X86
+
+__attribute__((target("sse2")))
+BlockMasks classifySSE2(const char *block) {
+    const __m128i commas = _mm_set1_epi8(',');
+    const __m128i quotes = _mm_set1_epi8('"');
+    const __m128i newlines = _mm_set1_epi8('\n');
+    
+    BlockMasks masks = {0, 0, 0};
+    for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+        masks.comma |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, commas)))) << i;
+        masks.quote |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quotes)))) << i;
+        masks.newline |= uint64_t(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newlines)))) << i;
+    }
+    return masks;
+}
+
+__attribute__((target("avx2")))
+uint64_t matchAVX2(const char *block, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+    uint64_t low = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+    uint64_t high = uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+    return low | (high << 32);
+}
+
+__attribute__((target("avx2")))
+BlockMasks classifyAVX2(const char *block) {
+    BlockMasks masks;
+    masks.comma = matchAVX2(block, ',');
+    masks.quote = matchAVX2(block, '"');
+    masks.newline = matchAVX2(block, '\n');
+    return masks;
+}
+
+#endif
+
+// Shared driver: full blocks through the classifier, the tail one byte at a time
+template <BlockMasks (*Classify)(const char *)>
+size_t scanWith(std::string_view buffer, size_t pos, std::vector<size_t> &fieldEnds) {
+    const char *data = buffer.data();
+    size_t length = buffer.size();
+    bool inQuotes = false;
+    
+    while (pos + BLOCK_SIZE <= length) {
+        BlockMasks masks = Classify(data + pos);
+        
+        // Quote parity at each byte decides which commas are delimiters
+        uint64_t quoted = prefixXor(masks.quote);
+        if (inQuotes) quoted = ~quoted;
+        uint64_t delimiters = masks.comma & ~quoted;
+        
+        if (masks.newline != 0) {
+            // Keep only the commas before the record's newline
+            int newlineBit = __builtin_ctzll(masks.newline);
+            delimiters &= (uint64_t(1) << newlineBit) - 1;
+            for (; delimiters != 0; delimiters &= delimiters - 1) {
+                fieldEnds.push_back(pos + __builtin_ctzll(delimiters));
+            }
+            fieldEnds.push_back(pos + newlineBit);
+            return pos + newlineBit;
+        }
+        
+        for (; delimiters != 0; delimiters &= delimiters - 1) {
+            fieldEnds.push_back(pos + __builtin_ctzll(delimiters));
+        }
+        inQuotes ^= (__builtin_popcountll(masks.quote) & 1) != 0;
+        pos += BLOCK_SIZE;
+    }
+    
+    for (; pos < length; pos++) {
+        char c = data[pos];
+        if (c == '"') {
+            inQuotes = !inQuotes;
+        } else if (c == ',' && !inQuotes) {
+            fieldEnds.push_back(pos);
+        } else if (c == '\n') {
+            break;
+        }
+    }
+    
+    fieldEnds.push_back(pos);
+    return pos;
+}
+
+}
+
+CSVTokenizer::Kernel CSVTokenizer::bestKernel() {
+#ifdef CSV_TOKENIZER_X86
+    static const Kernel best = __builtin_cpu_supports("avx2") ? Kernel::AVX2 : Kernel::SSE2;
+    return best;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+const char *CSVTokenizer::kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::AVX2: return "AVX2";
+        case Kernel::SSE2: return "SSE2";
+        default: return "Scalar";
+    }
+}
+
+size_t CSVTokenizer::scanRecord(std::string_view buffer, size_t pos,
+                                std::vector<size_t> &fieldEnds) {
+    return scanRecord(buffer, pos, fieldEnds, bestKernel());
+}
+
+size_t CSVTokenizer::scanRecord(std::string_view buffer, size_t pos,
+                                std::vector<size_t> &fieldEnds, Kernel kernel) {
+#ifdef CSV_TOKENIZER_X86
+    if (kernel == Kernel::AVX2) return scanWith<classifyAVX2>(buffer, pos, fieldEnds);
+    if (kernel == Kernel::SSE2) return scanWith<classifySSE2>(buffer, pos, fieldEnds);
+#endif
+    return scanWith<classifyScalar>(buffer, pos, fieldEnds);
+}
@@ -0,0 +1,385 @@
+#include "ColumnEncoding.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ColumnEncoding {
+
+namespace {
+
+// Append count values of width bits to words, starting on a fresh word
+void pack(const std::uint64_t *values, size_t count, unsigned width, std::vector<std::uint64_t> &words) {
+    if (width == 0) return;
+    size_t start = words.size();
+    words.resize(start + (count * width + 63) / 64, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        size_t bit = i * width;
+        size_t word = start + (bit >> 6);
+        unsigned offset = bit & 63;
+        words[word] |= values[i] << offset;
+        if (offset + width > 64) {
+            words[word + 1] |= values[i] >> (64 - offset);
+        }
+    }
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+std::uint64_t bitsOf(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double doubleOf(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Sequential bit stream over a word vector, least significant bit first
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::uint64_t> &words) : words(words), bit(0) {}
+
+    void write(std::uint64_t value, unsigned width) {
+        if (width < 64) value &= (1ULL << width) - 1;
+        unsigned offset = bit & 63;
+        if (offset == 0) words.push_back(0);
+        words.back() |= value << offset;
+        if (offset + width > 64) {
+            words.push_back(value >> (64 - offset));
+        }
+        bit += width;
+    }
+
+private:
+    std::vector<std::uint64_t> &words;
+    size_t bit;
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::uint64_t *words) : words(words), bit(0) {}
+
+    std::uint64_t read(unsigned width) {
+        size_t word = bit >> 6;
+        unsigned offset = bit & 63;
+        std::uint64_t value = words[word] >> offset;
+        if (offset + width > 64) {
+            value |= words[word + 1] << (64 - offset);
+        }
+        bit += width;
+        return width == 64 ? value : value & ((1ULL << width) - 1);
+    }
+
+private:
+    const std::uint64_t *words;
+    size_t bit;
+};
+
+}
+
+// ============================================================================
+// ForColumn
+// ============================================================================
+
+void ForColumn::append(std::int64_t value) {
+    tail.push_back(value);
+    if (tail.size() == BLOCK_ROWS) seal();
+}
+
+void ForColumn::seal() {
+    auto range = std::minmax_element(tail.begin(), tail.end());
+    std::int64_t base = *range.first;
+
+    std::uint64_t offsets[BLOCK_ROWS];
+    for (size_t i = 0; i < tail.size(); i++) {
+        offsets[i] = static_cast<std::uint64_t>(tail[i]) - static_cast<std::uint64_t>(base);
+    }
+
+    unsigned width = bitWidth(static_cast<std::uint64_t>(*range.second) - static_cast<std::uint64_t>(base));
+    blocks.push_back({words.size(), base, *range.second, width});
+    pack(offsets, tail.size(), width, words);
+
+    sealedRows += tail.size();
+    tail.clear();
+}
+
+std::pair<std::int64_t, std::int64_t> ForColumn::getBlockRange(size_t block) const {
+    if (block == blocks.size()) {
+        auto range = std::minmax_element(tail.begin(), tail.end());
+        return {*range.first, *range.second};
+    }
+    return {blocks[block].base, blocks[block].max};
+}
+
+void ForColumn::clear() {
+    blocks.clear();
+    words.clear();
+    tail.clear();
+    sealedRows = 0;
+}
+
+void ForColumn::shrinkToFit() {
+    blocks.shrink_to_fit();
+    words.shrink_to_fit();
+    tail.shrink_to_fit();
+}
+
+size_t ForColumn::memoryBytes() const {
+    return blocks.capacity() * sizeof(Block) + words.capacity() * sizeof(std::uint64_t) +
+           tail.capacity() * sizeof(std::int64_t);
+}
+
+// ============================================================================
+// DeltaColumn
+// ============================================================================
+
+void DeltaColumn::append(std::int64_t value) {
+    tail.push_back(value);
+    if (tail.size() == BLOCK_ROWS) seal();
+}
+
+void DeltaColumn::seal() {
+    // The first value lives in the header; deltas[0] is always 0
+    std::uint64_t deltas[BLOCK_ROWS];
+    std::uint64_t widest = 0;
+    deltas[0] = 0;
+
+    for (size_t i = 1; i < tail.size(); i++) {
+        std::int64_t delta = static_cast<std::int64_t>(
+            static_cast<std::uint64_t>(tail[i]) - static_cast<std::uint64_t>(tail[i - 1]));
+        deltas[i] = zigzag(delta);
+        widest |= deltas[i];
+    }
+
+    unsigned width = bitWidth(widest);
+    blocks.push_back({words.size(), tail.front(), width});
+    pack(deltas, tail.size(), width, words);
+
+    sealedRows += tail.size();
+    tail.clear();
+}
+
+void DeltaColumn::clear() {
+    blocks.clear();
+    words.clear();
+    tail.clear();
+    sealedRows = 0;
+}
+
+void DeltaColumn::shrinkToFit() {
+    blocks.shrink_to_fit();
+    words.shrink_to_fit();
+    tail.shrink_to_fit();
+}
+
+size_t DeltaColumn::memoryBytes() const {
+    return blocks.capacity() * sizeof(Block) + words.capacity() * sizeof(std::uint64_t) +
+           tail.capacity() * sizeof(std::int64_t);
+}
+
+size_t DeltaColumn::decodeBlock(size_t block, std::int64_t *out) const {
+    if (block == blocks.size()) {
+        std::copy(tail.begin(), tail.end(), out);
+        return tail.size();
+    }
+
+    const Block &header = blocks[block];
+    std::uint64_t deltas[BLOCK_ROWS];
+    unpack(words.data() + header.offset, header.width, BLOCK_ROWS, deltas);
+
+    std::uint64_t value = static_cast<std::uint64_t>(header.first);
+    for (size_t i = 0; i < BLOCK_ROWS; i++) {
+        value += static_cast<std::uint64_t>(unzigzag(deltas[i]));
+        out[i] = static_cast<std::int64_t>(value);
+    }
+    return BLOCK_ROWS;
+}
+
+// ============================================================================
+// DoubleColumn
+// ============================================================================
+
+namespace {
+
+const double POWERS_OF_TEN[] = {1.0, 10.0, 100.0, 1000.0, 10000.0};
+
+}
+
+void DoubleColumn::append(double value) {
+    tail.push_back(value);
+    if (tail.size() == BLOCK_ROWS) seal();
+}
+
+// Fewest decimals d such that every value is exactly round(value * 10^d) / 10^d,
+// or XOR_ENCODED. Division by an exact power of ten is correctly rounded, so
+// this holds for any value parsed from a literal with at most d decimals
+int DoubleColumn::findDecimals() const {
+    for (int decimals = 0; decimals <= MAX_DECIMALS; decimals++) {
+        double scale = POWERS_OF_TEN[decimals];
+        bool exact = true;
+
+        for (size_t i = 0; exact && i < tail.size(); i++) {
+            double scaled = tail[i] * scale;
+            if (!(std::abs(scaled) < 9007199254740992.0)) {     // 2^53, also rejects NaN
+                return XOR_ENCODED;
+            }
+            double restored = static_cast<double>(std::llround(scaled)) / scale;
+            exact = bitsOf(restored) == bitsOf(tail[i]);        // tells -0.0 from 0.0
+        }
+
+        if (exact) return decimals;
+    }
+    return XOR_ENCODED;
+}
+
+void DoubleColumn::seal() {
+    int decimals = findDecimals();
+    if (decimals == XOR_ENCODED) {
+        sealXor();
+        return;
+    }
+
+    double scale = POWERS_OF_TEN[decimals];
+    std::int64_t scaled[BLOCK_ROWS];
+    std::int64_t base = std::numeric_limits<std::int64_t>::max();
+    std::int64_t top = std::numeric_limits<std::int64_t>::lowest();
+    for (size_t i = 0; i < tail.size(); i++) {
+        scaled[i] = std::llround(tail[i] * scale);
+        base = std::min(base, scaled[i]);
+        top = std::max(top, scaled[i]);
+    }
+
+    std::uint64_t offsets[BLOCK_ROWS];
+    for (size_t i = 0; i < tail.size(); i++) {
+        offsets[i] = static_cast<std::uint64_t>(scaled[i] - base);
+    }
+
+    unsigned width = bitWidth(static_cast<std::uint64_t>(top - base));
+    blocks.push_back({words.size(), base, width, decimals});
+    pack(offsets, tail.size(), width, words);
+
+    sealedRows += tail.size();
+    tail.clear();
+}
+
+// Every value after the first is XORed with the previous one and written as
+// (bits in stream order):
+//   0                                       identical value
+//   1 0 <changed bits>                      fits the previous window
+//   1 1 <5: leading> <6: length-1> <bits>   opens a new window
+void DoubleColumn::sealXor() {
+    blocks.push_back({words.size(), 0, 0, XOR_ENCODED});
+
+    BitWriter writer(words);
+    std::uint64_t previous = bitsOf(tail.front());
+    writer.write(previous, 64);
+
+    unsigned windowLeading = 65;    // no window yet
+    unsigned windowTrailing = 0;
+
+    for (size_t i = 1; i < tail.size(); i++) {
+        std::uint64_t bits = bitsOf(tail[i]);
+        std::uint64_t changed = bits ^ previous;
+        previous = bits;
+
+        if (changed == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+
+        // Leading zeros are capped to fit in 5 bits
+        unsigned leading = std::min(static_cast<unsigned>(__builtin_clzll(changed)), 31u);
+        unsigned trailing = static_cast<unsigned>(__builtin_ctzll(changed));
+
+        if (windowLeading <= 64 && leading >= windowLeading && trailing >= windowTrailing) {
+            writer.write(0b01, 2);
+            writer.write(changed >> windowTrailing, 64 - windowLeading - windowTrailing);
+        } else {
+            unsigned length = 64 - leading - trailing;
+            writer.write(0b11, 2);
+            writer.write(leading, 5);
+            writer.write(length - 1, 6);
+            writer.write(changed >> trailing, length);
+            windowLeading = leading;
+            windowTrailing = trailing;
+        }
+    }
+
+    sealedRows += tail.size();
+    tail.clear();
+}
+
+void DoubleColumn::clear() {
+    blocks.clear();
+    words.clear();
+    tail.clear();
+    sealedRows = 0;
+}
+
+void DoubleColumn::shrinkToFit() {
+    blocks.shrink_to_fit();
+    words.shrink_to_fit();
+    tail.shrink_to_fit();
+}
+
+size_t DoubleColumn::memoryBytes() const {
+    return blocks.capacity() * sizeof(Block) + words.capacity() * sizeof(std::uint64_t) +
+           tail.capacity() * sizeof(double);
+}
+
+size_t DoubleColumn::decodeBlock(size_t block, double *out) const {
+    if (block == blocks.size()) {
+        std::copy(tail.begin(), tail.end(), out);
+        return tail.size();
+    }
+
+    const Block &header = blocks[block];
+    if (header.decimals != XOR_ENCODED) {
+        std::uint64_t offsets[BLOCK_ROWS];
+        unpack(words.data() + header.offset, header.width, BLOCK_ROWS, offsets);
+
+        double scale = POWERS_OF_TEN[header.decimals];
+        for (size_t i = 0; i < BLOCK_ROWS; i++) {
+            out[i] = static_cast<double>(header.base + static_cast<std::int64_t>(offsets[i])) / scale;
+        }
+        return BLOCK_ROWS;
+    }
+
+    BitReader reader(words.data() + header.offset);
+
+    std::uint64_t previous = reader.read(64);
+    out[0] = doubleOf(previous);
+
+    unsigned windowLeading = 0;
+    unsigned windowTrailing = 0;
+
+    for (size_t i = 1; i < BLOCK_ROWS; i++) {
+        if (reader.read(1) == 0) {
+            out[i] = doubleOf(previous);
+            continue;
+        }
+
+        if (reader.read(1) == 1) {
+            windowLeading = static_cast<unsigned>(reader.read(5));
+            unsigned length = static_cast<unsigned>(reader.read(6)) + 1;
+            windowTrailing = 64 - windowLeading - length;
+        }
+
+        previous ^= reader.read(64 - windowLeading - windowTrailing) << windowTrailing;
+        out[i] = doubleOf(previous);
+    }
+    return BLOCK_ROWS;
+}
+
+}
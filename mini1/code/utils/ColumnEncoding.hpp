@@ -0,0 +1,170 @@
+#ifndef COLUMN_ENCODING_HPP
+#define COLUMN_ENCODING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * ColumnEncoding - Lightweight compression for numeric columns
+ *
+ * Values are appended one at a time and sealed in blocks of BLOCK_ROWS;
+ * only the last, unsealed block is held plain. Blocks decode independently,
+ * so a scan decodes one block into a small buffer, runs its kernel there,
+ * and moves on; nothing is ever decompressed whole.
+ *
+ *   ForColumn    frame of reference: block minimum + fixed-width offsets
+ *                (small ranges such as AQI 0-500 or category 1-6)
+ *   DeltaColumn  first value + zigzag deltas, bit-packed like ForColumn
+ *                (timestamps, which barely change from row to row)
+ *   DoubleColumn measured values: a block of decimals with few digits
+ *                (163.9, -999) is scaled to integers and stored like
+ *                ForColumn; any other block falls back to Gorilla-style
+ *                XOR with the previous value, keeping only changed bits.
+ *                Both decode to the exact doubles that were appended.
+ */
+namespace ColumnEncoding {
+
+constexpr size_t BLOCK_ROWS = 4096;
+
+// Bits needed to store value (0 for 0)
+inline unsigned bitWidth(std::uint64_t value) {
+    return value ? 64 - static_cast<unsigned>(__builtin_clzll(value)) : 0;
+}
+
+// The count values of width bits starting at words[0], as unsigned integers
+inline void unpack(const std::uint64_t *words, unsigned width, size_t count, std::uint64_t *out) {
+    if (width == 0) {
+        for (size_t i = 0; i < count; i++) out[i] = 0;
+        return;
+    }
+    std::uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    for (size_t i = 0; i < count; i++) {
+        size_t bit = i * width;
+        size_t word = bit >> 6;
+        unsigned offset = bit & 63;
+        std::uint64_t value = words[word] >> offset;
+        if (offset + width > 64) {
+            value |= words[word + 1] << (64 - offset);
+        }
+        out[i] = value & mask;
+    }
+}
+
+// Frame-of-reference bit packing of integers
+class ForColumn {
+public:
+    void append(std::int64_t value);
+    void clear();
+    void shrinkToFit();
+
+    size_t size() const { return sealedRows + tail.size(); }
+    size_t getBlockCount() const { return blocks.size() + (tail.empty() ? 0 : 1); }
+    size_t memoryBytes() const;
+
+    // Exact min and max of a block, without decoding it
+    std::pair<std::int64_t, std::int64_t> getBlockRange(size_t block) const;
+
+    // Decode one block into out (room for BLOCK_ROWS); returns its row count
+    template <typename T>
+    size_t decodeBlock(size_t block, T *out) const;
+
+private:
+    struct Block {
+        size_t offset;          // first word in words
+        std::int64_t base;      // block minimum
+        std::int64_t max;
+        unsigned width;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::uint64_t> words;
+    std::vector<std::int64_t> tail;
+    size_t sealedRows = 0;
+
+    void seal();
+};
+
+// Delta + zigzag + bit packing of integers that change slowly
+class DeltaColumn {
+public:
+    void append(std::int64_t value);
+    void clear();
+    void shrinkToFit();
+
+    size_t size() const { return sealedRows + tail.size(); }
+    size_t getBlockCount() const { return blocks.size() + (tail.empty() ? 0 : 1); }
+    size_t memoryBytes() const;
+
+    size_t decodeBlock(size_t block, std::int64_t *out) const;
+
+private:
+    struct Block {
+        size_t offset;
+        std::int64_t first;
+        unsigned width;
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::uint64_t> words;
+    std::vector<std::int64_t> tail;
+    size_t sealedRows = 0;
+
+    void seal();
+};
+
+// Decimal-scaled bit packing, or Gorilla XOR, of doubles
+class DoubleColumn {
+public:
+    void append(double value);
+    void clear();
+    void shrinkToFit();
+
+    size_t size() const { return sealedRows + tail.size(); }
+    size_t getBlockCount() const { return blocks.size() + (tail.empty() ? 0 : 1); }
+    size_t memoryBytes() const;
+
+    size_t decodeBlock(size_t block, double *out) const;
+
+private:
+    static constexpr int MAX_DECIMALS = 4;
+    static constexpr int XOR_ENCODED = -1;
+
+    struct Block {
+        size_t offset;
+        std::int64_t base;      // minimum scaled value (decimal blocks)
+        unsigned width;
+        int decimals;           // or XOR_ENCODED
+    };
+
+    std::vector<Block> blocks;
+    std::vector<std::uint64_t> words;
+    std::vector<double> tail;
+    size_t sealedRows = 0;
+
+    void seal();
+    int findDecimals() const;
+    void sealXor();
+};
+
+template <typename T>
+size_t ForColumn::decodeBlock(size_t block, T *out) const {
+    if (block == blocks.size()) {
+        std::copy(tail.begin(), tail.end(), out);
+        return tail.size();
+    }
+
+    const Block &header = blocks[block];
+    std::uint64_t offsets[BLOCK_ROWS];
+    unpack(words.data() + header.offset, header.width, BLOCK_ROWS, offsets);
+    for (size_t i = 0; i < BLOCK_ROWS; i++) {
+        out[i] = static_cast<T>(static_cast<std::int64_t>(static_cast<std::uint64_t>(header.base) + offsets[i]));
+    }
+    return BLOCK_ROWS;
+}
+
+}
+
+#endif // COLUMN_ENCODING_HPP
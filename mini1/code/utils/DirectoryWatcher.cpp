@@ -0,0 +1,118 @@
+#include "DirectoryWatcher.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+DirectoryWatcher::DirectoryWatcher(const std::string &rootPath)
+    : fd(-1), rootPath(rootPath) {
+#ifdef __linux__
+    fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: inotify unavailable, polling " << rootPath << std::endl;
+        return;
+    }
+
+    watchFolder(rootPath, true);
+    watchDateFolders();
+#endif
+}
+
+DirectoryWatcher::~DirectoryWatcher() {
+#ifdef __linux__
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+}
+
+void DirectoryWatcher::watchFolder(const std::string &path, bool isRoot) {
+#ifdef __linux__
+    // The root only gains date folders; date folders gain CSV files
+    uint32_t mask = isRoot ? (IN_CREATE | IN_MOVED_TO | IN_ONLYDIR)
+                           : (IN_CLOSE_WRITE | IN_MOVED_TO);
+    int watch = ::inotify_add_watch(fd, path.c_str(), mask);
+    if (watch < 0) {
+        std::cerr << "Error: cannot watch " << path << std::endl;
+        return;
+    }
+    watchedFolders[watch] = path;
+#else
+    (void)path;
+    (void)isRoot;
+#endif
+}
+
+// Watch every folder under the root; folders already watched keep their watch
+void DirectoryWatcher::watchDateFolders() {
+    try {
+        for (const auto &entry : fs::directory_iterator(rootPath)) {
+            if (entry.is_directory()) {
+                watchFolder(entry.path().string(), false);
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading root directory " << rootPath
+                  << ": " << e.what() << std::endl;
+    }
+}
+
+bool DirectoryWatcher::waitForChange(int timeoutMillis) {
+#ifdef __linux__
+    if (fd >= 0) {
+        struct pollfd ready = {fd, POLLIN, 0};
+        if (::poll(&ready, 1, timeoutMillis) <= 0) {
+            return false;
+        }
+
+        // Drain every queued event; a burst of files is one change
+        alignas(struct inotify_event) char buffer[16 * 1024];
+        bool changed = false;
+        ssize_t length;
+        while ((length = ::read(fd, buffer, sizeof(buffer))) > 0) {
+            for (char *next = buffer; next < buffer + length; ) {
+                const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(next);
+                next += sizeof(struct inotify_event) + event->len;
+
+                // The kernel queue overflowed and dropped events, possibly
+                // new date folders too: watch them and let the caller rescan
+                if (event->mask & IN_Q_OVERFLOW) {
+                    watchDateFolders();
+                    changed = true;
+                    continue;
+                }
+
+                auto folder = watchedFolders.find(event->wd);
+                if (folder == watchedFolders.end()) continue;
+
+                // The folder is gone (deleted or unmounted) and so is its
+                // watch; losing the root means the caller has to look again
+                if (event->mask & IN_IGNORED) {
+                    changed = changed || folder->second == rootPath;
+                    watchedFolders.erase(folder);
+                    continue;
+                }
+                if (event->len == 0) continue;
+
+                // A new date folder may already hold files written before
+                // its watch existed; the caller's rescan picks those up
+                if ((event->mask & IN_ISDIR) && folder->second == rootPath) {
+                    watchFolder(folder->second + "/" + event->name, false);
+                }
+                changed = true;
+            }
+        }
+        return changed;
+    }
+#endif
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMillis));
+    return true;
+}
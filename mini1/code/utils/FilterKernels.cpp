@@ -0,0 +1,201 @@
+#include "FilterKernels.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILTER_KERNELS_X86 1
+#endif
+
+namespace {
+
+const size_t BLOCK_SIZE = 64;
+
+// Bit i of a block mask is set if block[i] is in [low, high]
+template <typename T>
+uint64_t matchScalar(const T *block, T low, T high) {
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i++) {
+        if (block[i] >= low && block[i] <= high) {
+            mask |= uint64_t(1) << i;
+        }
+    }
+    return mask;
+}
+
+#ifdef FILTER_KERNELS_X86
+
+__attribute__((target("avx2")))
+uint64_t matchIntAVX2(const int *block, int low, int high) {
+    const __m256i lows = _mm256_set1_epi32(low);
+    const __m256i highs = _mm256_set1_epi32(high);
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 8) {
+        __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + i));
+        // Only greater-than exists for integers, so test for outside and flip
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lows, values),
+                                          _mm256_cmpgt_epi32(values, highs));
+        uint32_t bits = ~uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(outside))) & 0xFF;
+        mask |= uint64_t(bits) << i;
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+uint64_t matchDoubleAVX2(const double *block, double low, double high) {
+    const __m256d lows = _mm256_set1_pd(low);
+    const __m256d highs = _mm256_set1_pd(high);
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 4) {
+        __m256d values = _mm256_loadu_pd(block + i);
+        __m256d inside = _mm256_and_pd(_mm256_cmp_pd(values, lows, _CMP_GE_OQ),
+                                       _mm256_cmp_pd(values, highs, _CMP_LE_OQ));
+        mask |= uint64_t(uint32_t(_mm256_movemask_pd(inside))) << i;
+    }
+    return mask;
+}
+
+__attribute__((target("avx512f")))
+uint64_t matchIntAVX512(const int *block, int low, int high) {
+    const __m512i lows = _mm512_set1_epi32(low);
+    const __m512i highs = _mm512_set1_epi32(high);
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+        __m512i values = _mm512_loadu_si512(block + i);
+        __mmask16 inside = _mm512_mask_cmple_epi32_mask(_mm512_cmpge_epi32_mask(values, lows),
+                                                        values, highs);
+        mask |= uint64_t(inside) << i;
+    }
+    return mask;
+}
+
+__attribute__((target("avx512f")))
+uint64_t matchDoubleAVX512(const double *block, double low, double high) {
+    const __m512d lows = _mm512_set1_pd(low);
+    const __m512d highs = _mm512_set1_pd(high);
+
+    uint64_t mask = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i += 8) {
+        __m512d values = _mm512_loadu_pd(block + i);
+        __mmask8 inside = _mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(values, lows, _CMP_GE_OQ),
+                                                  values, highs, _CMP_LE_OQ);
+        mask |= uint64_t(inside) << i;
+    }
+    return mask;
+}
+
+#endif
+
+// Run a block matcher over the column and emit the positions of set bits;
+// the tail shorter than a block goes through plain comparisons
+template <typename T, uint64_t (*matchBlock)(const T *, T, T)>
+size_t selectWith(const T *column, size_t count, T low, T high,
+                  std::uint32_t first, std::uint32_t *out) {
+    size_t written = 0;
+    size_t i = 0;
+
+    for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+        uint64_t mask = matchBlock(column + i, low, high);
+        while (mask) {
+            out[written++] = first + static_cast<std::uint32_t>(i + __builtin_ctzll(mask));
+            mask &= mask - 1;
+        }
+    }
+    for (; i < count; i++) {
+        if (column[i] >= low && column[i] <= high) {
+            out[written++] = first + static_cast<std::uint32_t>(i);
+        }
+    }
+
+    return written;
+}
+
+template <typename T, uint64_t (*matchBlock)(const T *, T, T)>
+size_t countWith(const T *column, size_t count, T low, T high) {
+    size_t matches = 0;
+    size_t i = 0;
+
+    for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+        matches += __builtin_popcountll(matchBlock(column + i, low, high));
+    }
+    for (; i < count; i++) {
+        if (column[i] >= low && column[i] <= high) {
+            matches++;
+        }
+    }
+
+    return matches;
+}
+
+}
+
+FilterKernels::Kernel FilterKernels::bestKernel() {
+#ifdef FILTER_KERNELS_X86
+    static const Kernel best = __builtin_cpu_supports("avx512f") ? Kernel::AVX512 :
+                               __builtin_cpu_supports("avx2") ? Kernel::AVX2 : Kernel::Scalar;
+    return best;
+#else
+    return Kernel::Scalar;
+#endif
+}
+
+const char *FilterKernels::kernelName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::AVX512: return "AVX-512";
+        case Kernel::AVX2: return "AVX2";
+        default: return "Scalar";
+    }
+}
+
+size_t FilterKernels::selectRange(const int *column, size_t count, int low, int high,
+                                  std::uint32_t first, std::uint32_t *out) {
+    return selectRange(column, count, low, high, first, out, bestKernel());
+}
+
+size_t FilterKernels::selectRange(const int *column, size_t count, int low, int high,
+                                  std::uint32_t first, std::uint32_t *out, Kernel kernel) {
+#ifdef FILTER_KERNELS_X86
+    if (kernel == Kernel::AVX512) return selectWith<int, matchIntAVX512>(column, count, low, high, first, out);
+    if (kernel == Kernel::AVX2) return selectWith<int, matchIntAVX2>(column, count, low, high, first, out);
+#endif
+    return selectWith<int, matchScalar<int>>(column, count, low, high, first, out);
+}
+
+size_t FilterKernels::selectRange(const double *column, size_t count, double low, double high,
+                                  std::uint32_t first, std::uint32_t *out) {
+    return selectRange(column, count, low, high, first, out, bestKernel());
+}
+
+size_t FilterKernels::selectRange(const double *column, size_t count, double low, double high,
+                                  std::uint32_t first, std::uint32_t *out, Kernel kernel) {
+#ifdef FILTER_KERNELS_X86
+    if (kernel == Kernel::AVX512) return selectWith<double, matchDoubleAVX512>(column, count, low, high, first, out);
+    if (kernel == Kernel::AVX2) return selectWith<double, matchDoubleAVX2>(column, count, low, high, first, out);
+#endif
+    return selectWith<double, matchScalar<double>>(column, count, low, high, first, out);
+}
+
+size_t FilterKernels::countRange(const int *column, size_t count, int low, int high) {
+    return countRange(column, count, low, high, bestKernel());
+}
+
+size_t FilterKernels::countRange(const int *column, size_t count, int low, int high, Kernel kernel) {
+#ifdef FILTER_KERNELS_X86
+    if (kernel == Kernel::AVX512) return countWith<int, matchIntAVX512>(column, count, low, high);
+    if (kernel == Kernel::AVX2) return countWith<int, matchIntAVX2>(column, count, low, high);
+#endif
+    return countWith<int, matchScalar<int>>(column, count, low, high);
+}
+
+size_t FilterKernels::countRange(const double *column, size_t count, double low, double high) {
+    return countRange(column, count, low, high, bestKernel());
+}
+
+size_t FilterKernels::countRange(const double *column, size_t count, double low, double high, Kernel kernel) {
+#ifdef FILTER_KERNELS_X86
+    if (kernel == Kernel::AVX512) return countWith<double, matchDoubleAVX512>(column, count, low, high);
+    if (kernel == Kernel::AVX2) return countWith<double, matchDoubleAVX2>(column, count, low, high);
+#endif
+    return countWith<double, matchScalar<double>>(column, count, low, high);
+}
@@ -0,0 +1,54 @@
+#ifndef FILTER_KERNELS_HPP
+#define FILTER_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * FilterKernels - Range predicates over contiguous numeric columns
+ *
+ * Compares 64 values at a time into a match bitmask (AVX-512 or AVX2 on
+ * x86, plain C++ elsewhere) and turns the set bits into a selection
+ * vector: the ascending positions of the matching values. Nothing is
+ * copied but the positions; callers gather whatever fields they need.
+ *
+ * Ranges are inclusive. NaN never matches, as with a plain comparison.
+ */
+class FilterKernels {
+public:
+    enum class Kernel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    // Fastest kernel the running CPU supports (detected once)
+    static Kernel bestKernel();
+
+    static const char *kernelName(Kernel kernel);
+
+    /**
+     * Select the values of column[0, count) with low <= value <= high.
+     *
+     * Writes first + i for every matching i to out, in order; out must
+     * have room for count entries.
+     *
+     * @return Number of positions written
+     */
+    static size_t selectRange(const int *column, size_t count, int low, int high,
+                              std::uint32_t first, std::uint32_t *out);
+    static size_t selectRange(const int *column, size_t count, int low, int high,
+                              std::uint32_t first, std::uint32_t *out, Kernel kernel);
+    static size_t selectRange(const double *column, size_t count, double low, double high,
+                              std::uint32_t first, std::uint32_t *out);
+    static size_t selectRange(const double *column, size_t count, double low, double high,
+                              std::uint32_t first, std::uint32_t *out, Kernel kernel);
+
+    // Number of values with low <= value <= high (no selection vector)
+    static size_t countRange(const int *column, size_t count, int low, int high);
+    static size_t countRange(const int *column, size_t count, int low, int high, Kernel kernel);
+    static size_t countRange(const double *column, size_t count, double low, double high);
+    static size_t countRange(const double *column, size_t count, double low, double high, Kernel kernel);
+};
+
+#endif // FILTER_KERNELS_HPP
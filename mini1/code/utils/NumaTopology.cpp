@@ -0,0 +1,121 @@
+#include "NumaTopology.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace NumaTopology {
+
+std::vector<int> parseCPUList(const std::string &list) {
+    std::vector<int> cpus;
+    std::stringstream ranges(list);
+    std::string range;
+
+    while (std::getline(ranges, range, ',')) {
+        size_t dash = range.find('-');
+        try {
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception &) {
+            // Blank or malformed entry (e.g. the trailing newline): skip it
+        }
+    }
+    return cpus;
+}
+
+std::vector<Node> nodes() {
+    namespace fs = std::filesystem;
+    std::vector<Node> result;
+
+    std::error_code error;
+    for (const auto &entry : fs::directory_iterator("/sys/devices/system/node", error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+            continue;
+        }
+
+        std::ifstream cpuList(entry.path() / "cpulist");
+        std::string list;
+        std::getline(cpuList, list);
+
+        Node node{std::stoi(name.substr(4)), parseCPUList(list)};
+        if (!node.cpus.empty()) {
+            result.push_back(node);
+        }
+    }
+
+    if (result.empty()) {
+        Node machine{0, {}};
+        unsigned cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned cpu = 0; cpu < cpus; cpu++) {
+            machine.cpus.push_back(static_cast<int>(cpu));
+        }
+        result.push_back(machine);
+    }
+
+    std::sort(result.begin(), result.end(), [](const Node &a, const Node &b) {
+        return a.id < b.id;
+    });
+    return result;
+}
+
+bool bindCurrentThread(const std::vector<int> &cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+bool interleaveCurrentThread(const std::vector<Node> &nodes) {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    const size_t bitsPerWord = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask;
+    for (const auto &node : nodes) {
+        if (node.id < 0) continue;
+        size_t id = static_cast<size_t>(node.id);
+        if (mask.size() <= id / bitsPerWord) {
+            mask.resize(id / bitsPerWord + 1, 0);
+        }
+        mask[id / bitsPerWord] |= 1UL << (id % bitsPerWord);
+    }
+    if (mask.empty()) return false;
+
+    // The kernel reads maxnode - 1 bits of the mask
+    return ::syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, mask.data(), mask.size() * bitsPerWord + 1) == 0;
+#else
+    (void)nodes;
+    return false;
+#endif
+}
+
+bool resetCurrentThreadMemory() {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+    return ::syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+}
@@ -0,0 +1,44 @@
+#ifndef NUMA_TOPOLOGY_HPP
+#define NUMA_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * NumaTopology - NUMA nodes of this machine and thread placement on them
+ *
+ * Nodes and their CPUs are read from /sys/devices/system/node (Linux), so
+ * no libnuma is needed. Memory placement relies on first touch: pages are
+ * backed on the node of the thread that first writes them, so data built
+ * by a thread bound to a node is local to that node. An interleave policy
+ * (set_mempolicy, also called directly) instead spreads the pages a thread
+ * touches round-robin over nodes. Where the topology cannot be read, the
+ * machine is one node holding every CPU.
+ */
+namespace NumaTopology {
+
+struct Node {
+    int id;
+    std::vector<int> cpus;
+};
+
+// Nodes with at least one online CPU, by node id
+std::vector<Node> nodes();
+
+// Parse a sysfs CPU list such as "0-3,8-11"
+std::vector<int> parseCPUList(const std::string &list);
+
+// Restrict the calling thread (and threads it starts later) to cpus;
+// false if that is not supported or the CPUs are not available
+bool bindCurrentThread(const std::vector<int> &cpus);
+
+// Back the pages the calling thread touches from now on round-robin across
+// nodes, until resetCurrentThreadMemory(); false if that is not supported
+bool interleaveCurrentThread(const std::vector<Node> &nodes);
+
+// Return the calling thread to first-touch (local) placement
+bool resetCurrentThreadMemory();
+
+}
+
+#endif // NUMA_TOPOLOGY_HPP
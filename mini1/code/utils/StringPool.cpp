@@ -0,0 +1,59 @@
+#include "StringPool.hpp"
+#include <mutex>
+
+StringPool &StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::~StringPool() {
+    for (auto &chunk : chunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+StringPool::Code StringPool::intern(std::string_view str) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = codes.find(str);
+        if (it != codes.end()) {
+            return it->second;
+        }
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    
+    // Another thread may have added it while we waited for the lock
+    auto it = codes.find(str);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    
+    Code code = static_cast<Code>(count);
+    size_t index = count + FIRST_CHUNK_SIZE;
+    unsigned chunk = 63 - static_cast<unsigned>(__builtin_clzll(index)) - FIRST_CHUNK_BITS;
+    
+    // Existing strings never move: a full chunk is followed by a new, twice larger one
+    std::string *strings = chunks[chunk].load(std::memory_order_relaxed);
+    if (!strings) {
+        strings = new std::string[FIRST_CHUNK_SIZE << chunk];
+        chunks[chunk].store(strings, std::memory_order_release);
+    }
+    
+    std::string &slot = strings[index - (FIRST_CHUNK_SIZE << chunk)];
+    slot.assign(str.data(), str.size());
+    codes.emplace(std::string_view(slot), code);
+    count++;
+    return code;
+}
+
+StringPool::Code StringPool::find(std::string_view str) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    auto it = codes.find(str);
+    return it != codes.end() ? it->second : NOT_FOUND;
+}
+
+size_t StringPool::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return count;
+}
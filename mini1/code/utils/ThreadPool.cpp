@@ -0,0 +1,147 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Set on each worker thread, so submit() can find the worker's own deque
+thread_local const ThreadPool *currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+}
+
+ThreadPool::ThreadPool(unsigned numThreads) {
+    numThreads = std::max(numThreads, 1u);
+
+    for (unsigned i = 0; i < numThreads; i++) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    for (unsigned i = 0; i < numThreads; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+int ThreadPool::workerIndex() const {
+    return currentPool == this ? currentWorker : -1;
+}
+
+void ThreadPool::submit(Task task) {
+    int self = workerIndex();
+    unsigned target = self >= 0 ? static_cast<unsigned>(self)
+                                : nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+
+    // Counted before it is visible, so the count never drops below zero
+    queued.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+
+    // Taking the lock orders this with a worker that is about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeUp.notify_one();
+}
+
+// Own deque from the back, then everyone else's from the front
+bool ThreadPool::takeTask(int self, Task &task) {
+    if (self >= 0) {
+        Queue &own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+
+    unsigned start = self >= 0 ? static_cast<unsigned>(self) + 1 : 0;
+    for (unsigned offset = 0; offset < size(); offset++) {
+        unsigned victim = (start + offset) % size();
+        if (static_cast<int>(victim) == self) continue;
+
+        Queue &other = *queues[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            queued.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::runPendingTask() {
+    Task task;
+    if (!takeTask(workerIndex(), task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentWorker = static_cast<int>(index);
+
+    Task task;
+    while (true) {
+        if (takeTask(currentWorker, task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) {
+            return;
+        }
+    }
+}
+
+void TaskGroup::run(ThreadPool::Task task) {
+    pending.fetch_add(1);
+    pool.submit([this, task = std::move(task)] {
+        task();
+
+        // Decrement under the lock: wait() takes it before returning, so
+        // the group cannot be destroyed while this task still touches it
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.fetch_sub(1) == 1) {
+            done.notify_all();
+        }
+    });
+}
+
+void TaskGroup::wait() {
+    while (pending.load() > 0) {
+        if (pool.runPendingTask()) continue;
+
+        // Nothing to help with: sleep briefly, tasks may fan out meanwhile
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait_for(lock, std::chrono::microseconds(200), [this] { return pending.load() == 0; });
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+}
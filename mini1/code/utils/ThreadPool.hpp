@@ -0,0 +1,93 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * ThreadPool - Fixed set of worker threads with work stealing
+ *
+ * Every worker owns a deque of tasks. A task submitted from a worker goes
+ * to the back of that worker's deque and the worker takes its newest task
+ * first (depth-first, cache-warm), while idle workers steal the oldest task
+ * from the front of someone else's deque - typically a coarse task that
+ * will fan out further. Tasks submitted from outside the pool are spread
+ * round-robin over the deques. Idle workers sleep until work is queued.
+ *
+ * Tasks must not throw. Destroying the pool runs every queued task and
+ * then joins the workers.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(unsigned numThreads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(Task task);
+
+    // Run one queued task on the calling thread; false if none was found
+    bool runPendingTask();
+
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+
+    // Process-wide pool sized to the machine, for code that has no pool of its own
+    static ThreadPool &shared();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;     // one per worker, all made before any worker starts
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{0};
+    std::atomic<unsigned> nextQueue{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;                          // guarded by sleepMutex
+
+    // The worker the calling thread is, if it belongs to this pool
+    int workerIndex() const;
+    bool takeTask(int self, Task &task);
+    void workerLoop(unsigned index);
+};
+
+/**
+ * TaskGroup - Fork/join over a ThreadPool
+ *
+ * run() submits a task (tasks may run() further tasks into the same group)
+ * and wait() returns once all of them have finished. A waiting thread runs
+ * queued tasks itself instead of blocking, so groups can be waited on from
+ * inside pool tasks without starving the pool.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool) : pool(pool) {}
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    void run(ThreadPool::Task task);
+    void wait();
+
+private:
+    ThreadPool &pool;
+    std::atomic<size_t> pending{0};
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+#endif // THREAD_POOL_HPP
@@ -1,16 +1,18 @@
 #include "include/PopulationDataManager.hpp"
 #include "include/WorldBankCSVLoader.hpp"
+#include <utility>
 
-void PopulationDataManager::loadFromCSV(const std::string& filename) {
+void PopulationDataManager::loadFromCSV(const std::string& filename, CSVReadMode mode) {
     
-    WorldBankCSVLoader::loadFromCSV(filename, [this](const PopulationDTO& dto) {
-        countries.push_back(dto);
-    });
+    WorldBankCSVLoader::loadFromCSV(filename, [this](PopulationDTO&& dto) {
+        countries.push_back(std::move(dto));
+    }, mode, &arena);
     
 }
 
 void PopulationDataManager::clear() {
     countries.clear();
+    arena.release();
 }
 
 size_t PopulationDataManager::getCountryCount() const {
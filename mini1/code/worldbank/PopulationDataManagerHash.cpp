@@ -1,15 +1,17 @@
 #include "include/PopulationDataManagerHash.hpp"
 #include "include/WorldBankCSVLoader.hpp"
+#include <utility>
 
-void PopulationDataManagerHash::loadFromCSV(const std::string& filename) {
+void PopulationDataManagerHash::loadFromCSV(const std::string& filename, CSVReadMode mode) {
     
-    WorldBankCSVLoader::loadFromCSV(filename, [this](const PopulationDTO& dto) {
-        countriesHash[dto.getCountryCode()] = dto;
-    });
+    WorldBankCSVLoader::loadFromCSV(filename, [this](PopulationDTO&& dto) {
+        countriesHash.insert_or_assign(dto.getCountryCode(), std::move(dto));
+    }, mode, &arena);
 }
 
 void PopulationDataManagerHash::clear() {
     countriesHash.clear();
+    arena.release();
 }
 
 size_t PopulationDataManagerHash::getCountryCount() const {
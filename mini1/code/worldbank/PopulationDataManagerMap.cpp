@@ -1,16 +1,18 @@
 #include "include/PopulationDataManagerMap.hpp"
 #include "include/WorldBankCSVLoader.hpp"
+#include <utility>
 
-void PopulationDataManagerMap::loadFromCSV(const std::string& filename) {
+void PopulationDataManagerMap::loadFromCSV(const std::string& filename, CSVReadMode mode) {
     
-    WorldBankCSVLoader::loadFromCSV(filename, [this](const PopulationDTO& dto) {
-        countriesMap[dto.getCountryCode()] = dto;
-    });
+    WorldBankCSVLoader::loadFromCSV(filename, [this](PopulationDTO&& dto) {
+        countriesMap.insert_or_assign(dto.getCountryCode(), std::move(dto));
+    }, mode, &arena);
 
 }
 
 void PopulationDataManagerMap::clear() {
     countriesMap.clear();
+    arena.release();
 }
 
 size_t PopulationDataManagerMap::getCountryCount() const {
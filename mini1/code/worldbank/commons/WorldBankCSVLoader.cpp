@@ -1,71 +1,117 @@
 #include "WorldBankCSVLoader.hpp"
 #include "CSVParser.hpp"
+#include "CSVSchema.hpp"
+#include "MappedFile.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <utility>
+
+namespace {
+
+// Decoded fields of one World Bank data line
+struct WorldBankFields {
+    std::string_view countryName;
+    std::string_view countryCode;
+    std::string_view indicatorName;
+    std::string_view indicatorCode;
+    long population[PopulationDTO::NUM_YEARS];
+};
+
+// 4 metadata columns + 64 optional year columns (1960-2023)
+using WorldBankSchema = CSVSchema<WorldBankFields,
+    Column<0, &WorldBankFields::countryName>,
+    Column<1, &WorldBankFields::countryCode>,
+    Column<2, &WorldBankFields::indicatorName>,
+    Column<3, &WorldBankFields::indicatorCode>,
+    ColumnRange<4, PopulationDTO::NUM_YEARS, &WorldBankFields::population, ColumnPresence::Optional>>;
+
+}
 
 int WorldBankCSVLoader::loadFromCSV(
     const std::string& filename,
-    std::function<void(const PopulationDTO&)> callback
+    std::function<void(PopulationDTO&&)> callback,
+    CSVReadMode mode,
+    Arena* arena
 ) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
-        return 0;
-    }
-    
-    if (!skipMetadataLines(file)) {
-        std::cerr << "Error: Failed to skip metadata lines" << std::endl;
-        return 0;
-    }
-    
-    std::cout << "Skipped metadata lines, starting data load..." << std::endl;
-    
-    std::string line;
+    std::vector<std::string_view> fields;
+    std::vector<std::string> storage;
+    ColumnErrors errors{};
     int countriesLoaded = 0;
     
-    while (std::getline(file, line)) {
-        if (CSVParser::isEmpty(line)) continue;
+    auto handleLine = [&](std::string_view line) {
+        if (CSVParser::isEmpty(line)) return;
         
-        std::vector<std::string> fields = CSVParser::parseLine(line);
+        CSVParser::splitLine(line, fields, storage);
         
         // World Bank CSV: 4 metadata + 64 years = 68 fields
-        if (fields.size() < 68) {
+        if (fields.size() < FIELD_COUNT) {
             std::cerr << "Warning: Skipping malformed line (expected 68 fields, got " 
                       << fields.size() << ")" << std::endl;
-            continue;
+            return;
         }
         
-        std::string countryName = CSVParser::removeQuotes(fields[0]);
-        std::string countryCode = CSVParser::removeQuotes(fields[1]);
+        std::optional<PopulationDTO> dto = parseDataLine(fields, arena, errors);
+        if (dto) {
+            callback(std::move(*dto));
+            countriesLoaded++;
+        }
+    };
+    
+    if (mode == CSVReadMode::MemoryMapped) {
+        // Views point into the mapping, which lives until the end of this block
+        MappedFile file(filename);
+        if (!file.isOpen()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return 0;
+        }
         
-        PopulationDTO dto;
-        dto.setCountryName(countryName);
-        dto.setCountryCode(countryCode);
+        std::string_view buffer = file.view();
+        size_t pos = 0;
         
-        // Parse population data for years 1960-2023 (columns 4-67)
-        for (int i = 0; i < PopulationDTO::NUM_YEARS; i++) {
-            std::string valueStr = CSVParser::trim(fields[4 + i]);
-            
-            // Handle missing data
-            if (valueStr.empty() || valueStr == ".." || valueStr == "\"..\"") {
-                continue; // Leave as -1
-            }
-            
-            try {
-                valueStr = CSVParser::removeQuotes(valueStr);
-                long population = std::stol(valueStr);
-                dto.setPopulationForYear(PopulationDTO::START_YEAR + i, population);
-            } catch (const std::exception&) {
-                // Skip invalid values silently
-            }
+        // Skip first 5 lines (metadata + header)
+        int lineCount = 0;
+        while (lineCount < 5 && pos < buffer.length()) {
+            CSVParser::nextLine(buffer, pos);
+            lineCount++;
+        }
+        if (lineCount != 5) {
+            std::cerr << "Error: Failed to skip metadata lines" << std::endl;
+            return 0;
         }
         
-        callback(dto);
-        countriesLoaded++;
+        std::cout << "Skipped metadata lines, starting data load..." << std::endl;
+        
+        while (pos < buffer.length()) {
+            handleLine(CSVParser::nextLine(buffer, pos));
+        }
+    } else {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return 0;
+        }
+        
+        if (!skipMetadataLines(file)) {
+            std::cerr << "Error: Failed to skip metadata lines" << std::endl;
+            return 0;
+        }
+        
+        std::cout << "Skipped metadata lines, starting data load..." << std::endl;
+        
+        std::string line;
+        while (std::getline(file, line)) {
+            handleLine(line);
+        }
+        
+        file.close();
+    }
+    
+    size_t badValues = WorldBankSchema::totalErrors(errors);
+    if (badValues > 0) {
+        std::cerr << "Warning: " << badValues << " population values could not be parsed" << std::endl;
     }
     
-    file.close();
     std::cout << "Successfully loaded " << countriesLoaded << " countries" << std::endl;
     
     return countriesLoaded;
@@ -81,4 +127,19 @@ bool WorldBankCSVLoader::skipMetadataLines(std::ifstream& file) {
     }
     
     return lineCount == 5;
-}
\ No newline at end of file
+}
+
+std::optional<PopulationDTO> WorldBankCSVLoader::parseDataLine(const std::vector<std::string_view>& fields,
+                                                               Arena* arena, ColumnErrors& errors) {
+    static_assert(WorldBankSchema::FIELD_COUNT == FIELD_COUNT, "schema must cover 4 + NUM_YEARS columns");
+    
+    WorldBankFields row;
+    std::fill(std::begin(row.population), std::end(row.population), -1L);  // -1 = no data
+    
+    if (!WorldBankSchema::decode(fields, row, errors)) {
+        return std::nullopt;
+    }
+    
+    // The views still point into the line; the DTO copies them into the arena
+    return PopulationDTO(row.countryName, row.countryCode, row.population, arena);
+}
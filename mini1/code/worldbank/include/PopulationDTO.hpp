@@ -3,13 +3,19 @@
 #define POPULATIONDTO_HPP_
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include "Arena.hpp"
+
+// Strings and series that live in a manager's Arena, or on the heap without one
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+using PopulationSeries = std::vector<long, ArenaAllocator<long>>;
 
 class PopulationDTO {
 private:
-    std::string countryName;
-    std::string countryCode;
-    std::vector<long> population;
+    ArenaString countryName;
+    ArenaString countryCode;
+    PopulationSeries population;
     
 public:
     static const int START_YEAR = 1960;
@@ -25,16 +31,24 @@ public:
     PopulationDTO(const std::string& countryName, 
                 const std::string& countryCode, 
                 const std::vector<long>& population) {
-        this->countryName = countryName;
-        this->countryCode = countryCode;
-        this->population = population;
+        this->countryName.assign(countryName.data(), countryName.size());
+        this->countryCode.assign(countryCode.data(), countryCode.size());
+        this->population.assign(population.begin(), population.end());
     }
 
+    // Strings and series allocated straight from arena (the heap if null),
+    // with no temporaries; population holds NUM_YEARS values
+    PopulationDTO(std::string_view countryName, std::string_view countryCode,
+                  const long* population, Arena* arena)
+        : countryName(countryName.data(), countryName.size(), ArenaAllocator<char>(arena)),
+          countryCode(countryCode.data(), countryCode.size(), ArenaAllocator<char>(arena)),
+          population(population, population + NUM_YEARS, ArenaAllocator<long>(arena)) {}
+
     std::string getCountryName() const {
-        return countryName;
+        return std::string(countryName.data(), countryName.size());
     }
     std::string getCountryCode() const {
-        return countryCode;
+        return std::string(countryCode.data(), countryCode.size());
     }
 
     long getPopulationForYear(int year) const {
@@ -44,15 +58,15 @@ public:
         return population[year - START_YEAR];
     }
 
-    const std::vector<long>& getPopulation() const {
+    const PopulationSeries& getPopulation() const {
         return population;
     }
 
     void setCountryName(const std::string& countryName) {
-        this->countryName = countryName;
+        this->countryName.assign(countryName.data(), countryName.size());
     }
     void setCountryCode(const std::string& countryCode) {
-        this->countryCode = countryCode;
+        this->countryCode.assign(countryCode.data(), countryCode.size());
     }
     void setPopulationForYear(int year, long value) {
         if (year >= START_YEAR && year <= END_YEAR) {
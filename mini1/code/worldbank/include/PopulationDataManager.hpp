@@ -5,16 +5,20 @@
 #include <map>
 #include <string>
 #include "PopulationDTO.hpp"
+#include "CSVParser.hpp"
 
 class PopulationDataManager {
 private:
     
+    // Owns the strings and series of every stored DTO; declared first so
+    // the DTOs are destroyed before it
+    Arena arena;
     std::vector<PopulationDTO> countries;
 
 public:
     PopulationDataManager() = default;
     
-    void loadFromCSV(const std::string& filename);
+    void loadFromCSV(const std::string& filename, CSVReadMode mode = CSVReadMode::Stream);
     
     void clear();
     
@@ -28,6 +32,8 @@ public:
                                     int startYear, int endYear) const;
     
     const std::vector<PopulationDTO>& getAllCountries() const;
+    
+    const Arena& getArena() const { return arena; }
 };
 
 #endif // POPULATION_DATA_MANAGER_HPP
\ No newline at end of file
@@ -5,16 +5,19 @@
 #include <string>
 #include <vector>
 #include "PopulationDTO.hpp"
+#include "CSVParser.hpp"
 
 class PopulationDataManagerHash {
 private:
 
+    // Storage of the DTOs' strings and series, released by clear()
+    Arena arena;
     std::unordered_map<std::string, PopulationDTO> countriesHash;
 
 public:
     PopulationDataManagerHash() = default;
     
-    void loadFromCSV(const std::string& filename);
+    void loadFromCSV(const std::string& filename, CSVReadMode mode = CSVReadMode::Stream);
     
     void clear();
     
@@ -4,16 +4,19 @@
 #include <map>
 #include <string>
 #include "PopulationDTO.hpp"
+#include "CSVParser.hpp"
 
 class PopulationDataManagerMap {
 private:
 
+    // Storage of the DTOs' strings and series, released by clear()
+    Arena arena;
     std::map<std::string, PopulationDTO> countriesMap;
 
 public:
     PopulationDataManagerMap() = default;
     
-    void loadFromCSV(const std::string& filename);
+    void loadFromCSV(const std::string& filename, CSVReadMode mode = CSVReadMode::Stream);
     
     void clear();
     
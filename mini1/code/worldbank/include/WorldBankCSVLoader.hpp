@@ -1,10 +1,14 @@
 #ifndef WORLDBANK_CSV_LOADER_HPP
 #define WORLDBANK_CSV_LOADER_HPP
 
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
+#include <optional>
 #include "PopulationDTO.hpp"
+#include "CSVParser.hpp"
 
 /**
  * WorldBankCSVLoader - Common CSV parsing logic for World Bank data
@@ -18,25 +22,39 @@ public:
      * Parse World Bank CSV file and invoke callback for each country
      * 
      * @param filename Path to CSV file
-     * @param callback Function to call for each parsed PopulationDTO
+     * @param callback Function to call for each parsed PopulationDTO; move
+     *                 it into storage, a copy would go to the heap
+     * @param mode Stream (ifstream) or MemoryMapped (zero-copy) reading
+     * @param arena Where each DTO's strings and series are allocated, or
+     *              nullptr for the heap
      * @return Number of countries successfully loaded
      */
     static int loadFromCSV(
         const std::string& filename,
-        std::function<void(const PopulationDTO&)> callback
+        std::function<void(PopulationDTO&&)> callback,
+        CSVReadMode mode = CSVReadMode::Stream,
+        Arena* arena = nullptr
     );
 
 private:
+    // 4 metadata columns + one column per year
+    static const int FIELD_COUNT = 4 + PopulationDTO::NUM_YEARS;
+    
+    // Unparsable values per CSV column
+    using ColumnErrors = std::array<size_t, FIELD_COUNT>;
+    
     /**
      * Skip metadata lines and return true if successful
      */
     static bool skipMetadataLines(std::ifstream& file);
     
     /**
-     * Parse a single data line into PopulationDTO
-     * Returns nullptr if line is invalid
+     * Decode a tokenized data line into a PopulationDTO allocated from arena
+     * through the compile-time column schema; missing ("..") years stay -1
+     * Returns nothing if the line is invalid
      */
-    static PopulationDTO* parseDataLine(const std::string& line);
+    static std::optional<PopulationDTO> parseDataLine(const std::vector<std::string_view>& fields,
+                                                      Arena* arena, ColumnErrors& errors);
 };
 
 #endif // WORLDBANK_CSV_LOADER_HPP
\ No newline at end of file
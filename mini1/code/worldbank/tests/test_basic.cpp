@@ -62,6 +62,33 @@ int main() {
         }
     }
     
+    // Test 5: Arena-backed storage
+    std::cout << "\n--- Test 5: Arena Storage ---" << std::endl;
+    {
+        const Arena& arena = manager.getArena();
+        std::cout << "Arena: " << arena.getBytesUsed() << " bytes in " << arena.getChunkCount() 
+                  << " chunks for " << manager.getCountryCount() << " countries" << std::endl;
+        
+        long usaBefore = manager.getPopulation("USA", 2020);
+        
+        // A copy of a stored DTO must not share the arena clear() releases
+        const PopulationDTO* stored = manager.getCountryData("USA");
+        PopulationDTO usaCopy = stored != nullptr ? *stored : PopulationDTO();
+        std::cout << "Copy on heap: " 
+                  << (usaCopy.getPopulation().get_allocator().getArena() == nullptr ? "yes" : "NO") << std::endl;
+        {
+            BenchmarkTimer timer("Clear", true);
+            manager.clear();
+        }
+        std::cout << "After clear: " << arena.getChunkCount() << " chunks" << std::endl;
+        std::cout << "Copy after clear matches: " 
+                  << (usaCopy.getPopulationForYear(2020) == usaBefore ? "yes" : "NO") << std::endl;
+        
+        manager.loadFromCSV(csvPath);
+        std::cout << "Reload matches: " 
+                  << (manager.getPopulation("USA", 2020) == usaBefore ? "yes" : "NO") << std::endl;
+    }
+    
     std::cout << "\n================================================" << std::endl;
     std::cout << "All tests completed successfully!" << std::endl;
     
@@ -0,0 +1,110 @@
+#ifndef AIR_QUALITY_CSV_LOADER_HPP
+#define AIR_QUALITY_CSV_LOADER_HPP
+
+#include <string>
+#include <functional>
+#include <vector>
+#include "AirQualityReading.hpp"
+#include "CSVParser.hpp"
+
+class ThreadPool;
+
+/**
+ * AirQualityCSVLoader - Common CSV parsing logic for AirNow fire data
+ *
+ * Decodes the 13-column air quality layout (a compile-time CSVSchema, no
+ * exceptions; bad values are tallied per column) and hands every reading to
+ * a callback, so row-oriented and column-oriented storage implementations
+ * share the same parsing code.
+ */
+class AirQualityCSVLoader {
+public:
+    /**
+     * Parse a single AirNow CSV file and invoke callback for each reading
+     *
+     * @param filename Path to CSV file
+     * @param callback Function to call for each parsed AirQualityReading
+     * @param mode Stream (ifstream) or MemoryMapped (zero-copy) reading
+     * @return Number of readings successfully loaded
+     */
+    static int loadFromCSV(
+        const std::string &filename,
+        std::function<void(const AirQualityReading &)> callback,
+        CSVReadMode mode = CSVReadMode::Stream
+    );
+
+    /**
+     * Parse many AirNow CSV files concurrently, splitting each file into
+     * newline-aligned byte ranges so that even a single large file is spread
+     * over all threads. Readings reach the callback serially, in file order
+     * and then line order, exactly as if the files were loaded one by one.
+     *
+     * @param filenames Paths to CSV files (always memory-mapped)
+     * @param callback Function to call for each parsed AirQualityReading
+     * @param numThreads Number of OpenMP threads parsing ranges
+     * @return Number of readings successfully loaded
+     */
+    static int loadFromCSVFiles(
+        const std::vector<std::string> &filenames,
+        std::function<void(const AirQualityReading &)> callback,
+        int numThreads
+    );
+    
+    /**
+     * Same parse as loadFromCSVFiles, but hand back the readings of every
+     * byte range (file order, then range order) instead of replaying them
+     * through a callback, so callers can place them in parallel
+     */
+    static std::vector<std::vector<AirQualityReading>> loadRangesFromCSVFiles(
+        const std::vector<std::string> &filenames,
+        int numThreads
+    );
+    
+    /**
+     * Same output as loadRangesFromCSVFiles over listCSVFiles(rootPath), but
+     * scheduled as nested tasks on a work-stealing pool: one task per date
+     * folder lists its files, one task per file maps and splits it, one task
+     * per byte range parses it. Workers that run out of work steal the
+     * oldest queued task, so one large folder no longer idles the others.
+     */
+    static std::vector<std::vector<AirQualityReading>> loadRangesFromDirectory(
+        const std::string &rootPath,
+        ThreadPool &pool
+    );
+    
+    /**
+     * Parse every CSV file in one date folder (directory order)
+     *
+     * @return Number of readings successfully loaded
+     */
+    static int loadFromDateFolder(
+        const std::string &dateFolderPath,
+        std::function<void(const AirQualityReading &)> callback,
+        CSVReadMode mode = CSVReadMode::Stream
+    );
+
+    /**
+     * List the CSV files under a root of date folders, sorted by folder and
+     * then by file name so that loads are reproducible across filesystems
+     */
+    static std::vector<std::string> listCSVFiles(const std::string &rootPath);
+
+private:
+    // Smallest byte range worth handing to a thread
+    static constexpr size_t MIN_RANGE_BYTES = 64 * 1024;
+    
+    // Rough AirNow line length, used to pre-size each range's output
+    static constexpr size_t ESTIMATED_LINE_BYTES = 150;
+    
+    /**
+     * mmap the file and decode fields as views over the mapped bytes.
+     * Numbers are parsed in place and strings go straight into the
+     * StringPool, so only never-seen-before strings are ever copied.
+     */
+    static int loadFromMappedCSV(
+        const std::string &filename,
+        std::function<void(const AirQualityReading &)> &callback
+    );
+};
+
+#endif // AIR_QUALITY_CSV_LOADER_HPP
@@ -6,35 +6,158 @@
 #include <map>
 #include <string>
 #include <filesystem>
+#include <functional>
 #include "AirQualityReading.hpp"
+#include "CSVParser.hpp"
+#include "TimeIndex.hpp"
+#include "AQIIndex.hpp"
+#include "ZoneMaps.hpp"
+#include "ReadingView.hpp"
+#include "AirQualityQuery.hpp"
+#include "SpatialIndex.hpp"
+#include "RollupCube.hpp"
+#include "IngestManifest.hpp"
+#include "GroupBy.hpp"
 
 namespace fs = std::filesystem;
 
+class ThreadPool;
+
 class AirQualityDataManager {
 private:
     std::vector<AirQualityReading> readings;
-    std::map<std::string, std::vector<AirQualityReading>> readingsByDate;
-    std::map<std::string, std::vector<AirQualityReading>> readingsByPollutant;
+    
+    // Posting lists of row ids into readings, keyed by dictionary code
+    std::map<StringPool::Code, std::vector<RowId>> readingsByDate;
+    std::map<StringPool::Code, std::vector<RowId>> readingsByPollutant;
+    
+    // Rows sorted by epoch timestamp; rows from timeIndexedRows on are not in it yet
+    TimeIndex timeIndex;
+    size_t timeIndexedRows = 0;
+    
+    // Rows bucketed by AQI value (counting sort), new rows merged in after every load
+    AQIIndex aqiIndex;
+    
+    // Min/max of each 4K-row block, extended after every load
+    ZoneMaps zoneMaps;
+    
+    // Lat/lon grid of rows and sites, extended after every load
+    SpatialIndex spatialIndex;
+    
+    // Pollutant/site/hour statistics, extended after every load while enabled
+    RollupCube rollups;
+    bool rollupsEnabled = false;
+    
+    // Files loaded through ingestNewFiles(), with the rows each produced
+    IngestManifest manifest;
+
+    void addReading(const AirQualityReading &reading);
+    ReadingView viewRows(const std::vector<RowId> &rowIds, size_t first, size_t last) const;
+    void appendShards(std::vector<std::vector<AirQualityReading>> &shards);
+    void updateIndexes();
+    void updateRollups();
+    void removeRows(RowId first, RowId last);
+    void truncateRows(RowId first);
+    std::vector<RowId> runQuery(const AirQualityQuery &query, bool parallel) const;
+
+    CSVReadMode readMode = CSVReadMode::Stream;
 
 public:
+    // Choose how CSV files are read (default: Stream)
+    void setReadMode(CSVReadMode mode) { readMode = mode; }
+    
     void loadFromCSV(const std::string &filename);
     void loadFromDateFolder(const std::string &dateFolderPath);
     void loadFromDirectory(const std::string &rootPath);
     
+    // Nested folder -> file -> byte-range tasks on a work-stealing ThreadPool
+    // (files are memory-mapped); pass a pool to share it with other work
     void loadFromDirectoryParallel(const std::string &rootPath, int numThreads = 4);
+    void loadFromDirectoryParallel(const std::string &rootPath, ThreadPool &pool);
+    
+    // Intra-file parallelism: files are mmapped and split into byte ranges,
+    // rows keep the order of loading the (sorted) files serially
+    void loadFromCSVParallel(const std::string &filename, int numThreads = 4);
+    void loadFromDirectoryByteRanges(const std::string &rootPath, int numThreads = 4);
+    void loadFromCSVFiles(const std::vector<std::string> &filenames, int numThreads = 4);
+    
+    // Binary snapshot of readings, dictionary and indexes (AirQualitySnapshot);
+    // loading replaces the current contents and needs no CSV parsing
+    bool saveSnapshot(const std::string &path) const;
+    bool loadSnapshot(const std::string &path);
     
     void clear();
+    
+    // Incremental ingest against a manifest of path/size/mtime: load CSV files
+    // under rootPath that are new, reload ones rewritten since they were
+    // ingested, skip the rest, and extend every index in place. A rewritten
+    // file whose rows are the last loaded (the current hour) is cut off the
+    // tail of every index; any other rewritten file costs re-indexing every
+    // row, O(n). Returns the number of files read. Files loaded by the other
+    // load calls are not in the manifest, so use one or the other for a
+    // given directory
+    size_t ingestNewFiles(const std::string &rootPath);
+    
+    // Ingest, then keep ingesting whenever files land under rootPath (inotify
+    // on Linux, a rescan every timeoutMillis elsewhere). onIngest gets the
+    // number of files read after every wakeup, including timeouts with 0;
+    // watching stops when it returns false
+    void watchDirectory(const std::string &rootPath, const std::function<bool(size_t)> &onIngest,
+                        int timeoutMillis = 1000);
+    
+    const IngestManifest &getManifest() const { return manifest; }
+    
+    // Keep a rollup cube (RollupCube) up to date with every load. Enabling
+    // builds it over the rows already loaded; disabling drops it
+    void setRollupsEnabled(bool enabled);
+    bool getRollupsEnabled() const { return rollupsEnabled; }
+    const RollupCube &getRollups() const;
 
-    std::vector<AirQualityReading> getAllReadings() const;
+    // Queries return views of the stored readings (see ReadingView): no
+    // copies are made, and materialize() gives an owning vector if needed
+    ReadingView getAllReadings() const;
     int getReadingCount() const;
     
-    std::vector<AirQualityReading> getReadingsByDate(const std::string &date) const;
-    std::vector<AirQualityReading> getReadingsByPollutant(const std::string &pollutantType) const;
+    ReadingView getReadingsByDate(const std::string &date) const;
+    ReadingView getReadingsByPollutant(const std::string &pollutantType) const;
+    
+    // Posting list access - walk these with getReadingAt() instead of copying readings
+    const std::vector<RowId> &getRowIdsByDate(const std::string &date) const;
+    const std::vector<RowId> &getRowIdsByPollutant(const std::string &pollutantType) const;
+    const AirQualityReading &getReadingAt(RowId rowId) const;
     
-    std::vector<AirQualityReading> getReadingsByAQIRange(int minAQI, int maxAQI) const;
+    // Readings with start <= timestamp < end (UTC epoch seconds, see
+    // CSVParser::parseEpochSeconds), found by binary search in the time index
+    ReadingView getReadingsByTimeRange(std::int64_t start, std::int64_t end) const;
     
+    // Sorted time index with precomputed hour/day buckets, for rollups
+    const TimeIndex &getTimeIndex() const;
+    
+    // AQI queries use the AQI index: counts never scan, range fetches touch
+    // only qualifying rows (returned grouped by AQI value)
+    ReadingView getReadingsByAQIRange(int minAQI, int maxAQI) const;
+    
+    // Owning copy of the same range, gathered by all threads
     std::vector<AirQualityReading> getReadingsByAQIRangeParallel(int minAQI, int maxAQI) const;
     
+    // Conjunctive queries (AirQualityQuery). The planner drives a query from
+    // whichever of the pollutant, time, AQI and spatial indexes yields the fewest
+    // candidates (slice sizes are exact), or from a zone-pruned scan, and
+    // checks the remaining predicates in one pass. Row ids are in row order
+    QueryPlan planQuery(const AirQualityQuery &query) const;
+    std::vector<RowId> selectRows(const AirQualityQuery &query) const;
+    std::vector<RowId> selectRowsParallel(const AirQualityQuery &query) const;
+    
+    // View the readings at rowIds, valid while rowIds and the store are unchanged
+    ReadingView getReadingsAt(const std::vector<RowId> &rowIds) const;
+    
+    // Regional queries over the spatial grid: readings inside an inclusive
+    // lat/lon box (row order), and the k monitoring sites nearest a point
+    ReadingView getReadingsInBoundingBox(double south, double north, double west, double east) const;
+    std::vector<SpatialIndex::SiteDistance> getNearestSites(double latitude, double longitude, size_t k) const;
+    
+    // Average and max, serial or parallel, are answered from the rollup cube
+    // when it is enabled
     double getAveragePollutantValue(const std::string &pollutantType) const;
     double getMaxPollutantValue(const std::string &pollutantType) const;
     int countReadingsAboveAQI(int threshold) const;
@@ -43,6 +166,12 @@ public:
     double getMaxPollutantValueParallel(const std::string &pollutantType) const;
     int countReadingsAboveAQIParallel(int threshold) const;
     
+    // count/sum/min/max/mean per group of GroupBy columns (e.g.
+    // GroupBy::Pollutant | GroupBy::Site) in a single scan, sorted by key;
+    // the parallel scan keeps a hash table per thread and merges them
+    std::vector<GroupBy::Row> groupBy(unsigned columns) const;
+    std::vector<GroupBy::Row> groupByParallel(unsigned columns) const;
+    
     std::vector<std::string> getAllDates() const;
     std::vector<std::string> getAllPollutantTypes() const;
 };
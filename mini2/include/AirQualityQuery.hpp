@@ -0,0 +1,80 @@
+#ifndef AIR_QUALITY_QUERY_HPP
+#define AIR_QUALITY_QUERY_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include "AirQualityReading.hpp"
+#include "ZoneMaps.hpp"
+
+// Inclusive latitude/longitude rectangle (degrees)
+struct BoundingBox {
+    double south;
+    double north;
+    double west;
+    double east;
+
+    bool contains(double latitude, double longitude) const {
+        return latitude >= south && latitude <= north && longitude >= west && longitude <= east;
+    }
+};
+
+/**
+ * AirQualityQuery - Conjunction of predicates over readings
+ *
+ * Built by chaining, e.g.
+ *   AirQualityQuery().pollutant("PM2.5").timeRange(start, end).aqiAbove(150)
+ * and run with AirQualityDataManager::selectRows(). A predicate left unset
+ * matches everything; setting one twice keeps the intersection.
+ */
+class AirQualityQuery {
+public:
+    AirQualityQuery &pollutant(const std::string &pollutantType);
+    // Full AQS site id, e.g. "840060150007"
+    AirQualityQuery &site(const std::string &fullSiteId);
+    // start <= timestamp < end (UTC epoch seconds)
+    AirQualityQuery &timeRange(std::int64_t start, std::int64_t end);
+    AirQualityQuery &aqiRange(int minAQI, int maxAQI);
+    AirQualityQuery &aqiAbove(int threshold);
+    AirQualityQuery &category(int minCategory, int maxCategory);
+    AirQualityQuery &boundingBox(double south, double north, double west, double east);
+
+    // Every set predicate holds for reading
+    bool matches(const AirQualityReading &reading) const;
+
+    // False only if no row summarized by zone can match
+    bool mayMatch(const ZoneMaps::Zone &zone) const;
+
+    // The predicates, for the planner; codes of strings never seen are
+    // StringPool::NOT_FOUND and match nothing
+    std::optional<StringPool::Code> pollutantCode;
+    std::optional<StringPool::Code> siteCode;
+    std::optional<std::pair<std::int64_t, std::int64_t>> time;
+    std::optional<std::pair<int, int>> aqi;
+    std::optional<std::pair<int, int>> categories;
+    std::optional<BoundingBox> box;
+};
+
+/**
+ * QueryPlan - How AirQualityDataManager will run a query
+ *
+ * The driving access path yields candidate rows; the remaining predicates
+ * are checked on each candidate in a single fused pass.
+ */
+struct QueryPlan {
+    enum class Access {
+        ZoneScan,           // every block the zone maps cannot rule out
+        PollutantIndex,     // posting list of the pollutant
+        TimeIndex,          // slice of the time index
+        AQIIndex,           // slice of the AQI index
+        SpatialIndex        // grid cells overlapping the bounding box
+    };
+
+    Access access = Access::ZoneScan;
+    size_t candidateRows = 0;
+
+    static const char *accessName(Access access);
+};
+
+#endif // AIR_QUALITY_QUERY_HPP
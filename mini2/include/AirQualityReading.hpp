@@ -1,62 +1,99 @@
-
 #ifndef AIR_QUALITY_READING_HPP
 #define AIR_QUALITY_READING_HPP
 
 #include <string>
+#include <cstdint>
+#include "StringPool.hpp"
+#include "CSVParser.hpp"
+
+// Position of a reading inside a manager's primary store
+using RowId = std::uint32_t;
 
 class AirQualityReading
 {
 private:
     double latitude;
     double longitude;
-    std::string datetime;
-    std::string pollutantType;
     double value;
-    std::string unit;
     double rawConcentration;
+    std::int64_t timestamp;    // datetime as UTC epoch seconds, parsed once at load
     int airQualityIndex;
     int category;
-    std::string siteName;
-    std::string agencyName;
-    std::string siteId;
-    std::string fullSiteId;
+
+    // String fields are dictionary-encoded in StringPool::global()
+    StringPool::Code datetime;
+    StringPool::Code pollutantType;
+    StringPool::Code unit;
+    StringPool::Code siteName;
+    StringPool::Code agencyName;
+    StringPool::Code siteId;
+    StringPool::Code fullSiteId;
 
 public:
+    // Timestamp of a reading whose datetime could not be parsed
+    static constexpr std::int64_t NO_TIMESTAMP = INT64_MIN;
+
+    // Empty reading, so storage can be sized first and filled in parallel
+    AirQualityReading() = default;
+
     AirQualityReading(double lat, double lon, const std::string &dt, const std::string &pollutant,
                       double val, const std::string &u, double rawConcenteration, int aqi, int cat,
                       const std::string &site, const std::string &agency, const std::string &siteId, const std::string &fullSiteId)
     {
+        StringPool &pool = StringPool::global();
 
         this->latitude = lat;
         this->longitude = lon;
-        this->datetime = dt;
-        this->pollutantType = pollutant;
+        this->datetime = pool.intern(dt);
+        if (!CSVParser::parseEpochSeconds(dt, this->timestamp)) {
+            this->timestamp = NO_TIMESTAMP;
+        }
+        this->pollutantType = pool.intern(pollutant);
         this->value = val;
-        this->unit = u;
+        this->unit = pool.intern(u);
         this->rawConcentration = rawConcenteration;
         this->airQualityIndex = aqi;
         this->category = cat;
-        this->siteName = site;
-        this->agencyName = agency;
-        this->siteId = siteId;
-        this->fullSiteId = fullSiteId;
+        this->siteName = pool.intern(site);
+        this->agencyName = pool.intern(agency);
+        this->siteId = pool.intern(siteId);
+        this->fullSiteId = pool.intern(fullSiteId);
     }
 
-    // Getter methods
+    // Build a reading from already interned codes
+    AirQualityReading(double lat, double lon, StringPool::Code dt, StringPool::Code pollutant,
+                      double val, StringPool::Code u, double rawConcenteration, int aqi, int cat,
+                      StringPool::Code site, StringPool::Code agency, StringPool::Code siteId, StringPool::Code fullSiteId,
+                      std::int64_t timestamp)
+        : latitude(lat), longitude(lon), value(val), rawConcentration(rawConcenteration),
+          timestamp(timestamp), airQualityIndex(aqi), category(cat), datetime(dt), pollutantType(pollutant),
+          unit(u), siteName(site), agencyName(agency), siteId(siteId), fullSiteId(fullSiteId) {}
+
+    // Getter methods - string getters decode through the pool on demand
     double getLatitude() const { return latitude; }
     double getLongitude() const { return longitude; }
-    std::string getDatetime() const { return datetime; }
-    std::string getPollutantType() const { return pollutantType; }
+    const std::string &getDatetime() const { return StringPool::global().get(datetime); }
+    std::int64_t getTimestamp() const { return timestamp; }
+    const std::string &getPollutantType() const { return StringPool::global().get(pollutantType); }
     double getValue() const { return value; }
-    std::string getUnit() const { return unit; }
+    const std::string &getUnit() const { return StringPool::global().get(unit); }
     double getRawConcentration() const { return rawConcentration; }
     int getAirQualityIndex() const { return airQualityIndex; }
     int getCategory() const { return category; }
-    std::string getSiteName() const { return siteName; }
-    std::string getAgencyName() const { return agencyName; }
-    std::string getSiteId() const { return siteId; }
-    std::string getFullSiteId() const { return fullSiteId; }
+    const std::string &getSiteName() const { return StringPool::global().get(siteName); }
+    const std::string &getAgencyName() const { return StringPool::global().get(agencyName); }
+    const std::string &getSiteId() const { return StringPool::global().get(siteId); }
+    const std::string &getFullSiteId() const { return StringPool::global().get(fullSiteId); }
+
+    // Dictionary codes - compare these instead of strings in filters
+    StringPool::Code getDatetimeCode() const { return datetime; }
+    StringPool::Code getPollutantTypeCode() const { return pollutantType; }
+    StringPool::Code getUnitCode() const { return unit; }
+    StringPool::Code getSiteNameCode() const { return siteName; }
+    StringPool::Code getAgencyNameCode() const { return agencyName; }
+    StringPool::Code getSiteIdCode() const { return siteId; }
+    StringPool::Code getFullSiteIdCode() const { return fullSiteId; }
 
 };
 
-#endif // AIR_QUALITY_READING_HPP
\ No newline at end of file
+#endif // AIR_QUALITY_READING_HPP
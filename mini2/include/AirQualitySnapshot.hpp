@@ -0,0 +1,64 @@
+#ifndef AIR_QUALITY_SNAPSHOT_HPP
+#define AIR_QUALITY_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AirQualityReading.hpp"
+#include "PostingLists.hpp"
+#include "TimeIndex.hpp"
+
+/**
+ * AirQualitySnapshot - Binary image of a loaded AirQualityDataManager
+ *
+ * Parsing a month of CSV takes seconds; a snapshot is written once (see
+ * tools/csv_to_snapshot) and then mmapped at startup, checked, and bulk
+ * copied into place with no parsing. The posting lists and the time index
+ * (the sorts) are stored; the AQI index, zone maps and spatial index are
+ * rebuilt by the manager from the loaded columns, each one linear pass.
+ *
+ * Layout (native byte order, every section 8-byte aligned):
+ *   header      magic "AQSNAP\0\0", version, row/dictionary counts,
+ *               payload size and checksum (FNV-1a over 64-bit words)
+ *               of everything after it
+ *   dictionary  uint32 end offsets, then the string bytes
+ *   columns     latitude, longitude, value, rawConcentration (double),
+ *               timestamp (int64 epoch seconds), airQualityIndex,
+ *               category (int32), then the 7 string
+ *               columns as uint32 dictionary codes
+ *   indexes     by date, then by pollutant: key count, keys,
+ *               uint64 list end offsets, row ids; then the time index
+ *               as a row count and row ids in time order
+ *
+ * Dictionary codes are local to the file and remapped into
+ * StringPool::global() on load, so any process can read any snapshot.
+ */
+class AirQualitySnapshot {
+public:
+    static constexpr std::uint32_t VERSION = 2;
+
+    /**
+     * Write readings and their indexes to path
+     *
+     * @return false (with a message on stderr) if the file cannot be written
+     */
+    static bool write(const std::string &path,
+                      const std::vector<AirQualityReading> &readings,
+                      const PostingLists &byDate,
+                      const PostingLists &byPollutant,
+                      const TimeIndex &byTime);
+
+    /**
+     * Replace readings and indexes with the contents of a snapshot
+     *
+     * @return false (with a message on stderr) if the file is missing, has
+     *         another version, or fails its checksum; outputs are then empty
+     */
+    static bool read(const std::string &path,
+                     std::vector<AirQualityReading> &readings,
+                     PostingLists &byDate,
+                     PostingLists &byPollutant,
+                     TimeIndex &byTime);
+};
+
+#endif // AIR_QUALITY_SNAPSHOT_HPP
@@ -1,17 +1,64 @@
+#ifndef CSV_PARSER_HPP
+#define CSV_PARSER_HPP
+
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <utility>
+
+// How a loader reads its CSV files
+enum class CSVReadMode {
+    Stream,         // std::ifstream + std::getline, one std::string per field
+    MemoryMapped    // mmap the file and tokenize into views over the mapped bytes
+};
 
 class CSVParser {
 public:
-    // Parse a single CSV line into fields
+    // Parse a single CSV line into fields (SIMD tokenizer, see CSVTokenizer)
     static std::vector<std::string> parseLine(const std::string &line);
     
+    // Character-at-a-time reference parser with the same results as parseLine
+    static std::vector<std::string> parseLineScalar(const std::string &line);
+    
+    // Parse a single CSV line into views over the line's bytes (no copies).
+    // Enclosing quotes are stripped. Returns false if some field has quotes
+    // that a view cannot represent; use parseLine() for that line instead.
+    static bool parseLineView(std::string_view line, std::vector<std::string_view> &fields);
+    
+    // Split a line into views: over the line itself when possible, otherwise
+    // over copies kept in storage (lines whose fields need quote removal)
+    static void splitLine(std::string_view line, std::vector<std::string_view> &fields,
+                          std::vector<std::string> &storage);
+    
+    // Return the line starting at pos in a buffer and move pos past its newline.
+    // Like std::getline, the newline is dropped but a '\r' before it is kept.
+    static std::string_view nextLine(std::string_view buffer, size_t &pos);
+    
+    // Cut a buffer into [begin, end) byte ranges of about targetBytes each,
+    // every range starting at a line start and ending just past a newline
+    // (or at the end of the buffer). Assumes no quoted field spans lines.
+    static std::vector<std::pair<size_t, size_t>> splitLineRanges(std::string_view buffer,
+                                                                  size_t targetBytes);
+    
+    // Parse numbers in place; return false if str does not start with a number
+    static bool parseDouble(std::string_view str, double &value);
+    static bool parseInt(std::string_view str, int &value);
+    static bool parseLong(std::string_view str, long &value);
+    
+    // Parse an ISO-8601 UTC date/time ("2020-08-10", "2020-08-10T01:00",
+    // "2020-08-10T01:00:00Z") into seconds since the Unix epoch
+    static bool parseEpochSeconds(std::string_view str, std::int64_t &seconds);
+    
     // Remove quotes from a string
     static std::string removeQuotes(const std::string &str);
     
     // Check if a line is empty or whitespace only
-    static bool isEmpty(const std::string &line);
+    static bool isEmpty(std::string_view line);
     
     // Trim whitespace from both ends
     static std::string trim(const std::string &str);
-};
\ No newline at end of file
+    static std::string_view trimView(std::string_view str);
+};
+
+#endif // CSV_PARSER_HPP
@@ -80,6 +80,8 @@ public:
 
   /**
    * Convert AirQualityReading to protobuf AirQualityData
+   * String fields are decoded from their dictionary codes only here, at the
+   * point a reading is actually sent
    */
   template<typename ReadingType>
   static AirQualityData convertToProtobuf(const ReadingType& reading) {
@@ -0,0 +1,51 @@
+#ifndef INGEST_MANIFEST_HPP
+#define INGEST_MANIFEST_HPP
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include "AirQualityReading.hpp"
+
+/**
+ * IngestManifest - Which CSV files are loaded, and where their rows are
+ *
+ * Each ingested file is recorded with the size and modification time it had
+ * when it was read and the run of rows it produced, so a rescan of the data
+ * directory can tell new files from rewritten ones from files that are
+ * already current using nothing but a stat() per file.
+ */
+class IngestManifest {
+public:
+    struct FileEntry {
+        std::uint64_t size = 0;
+        std::int64_t modified = 0;     // filesystem clock ticks
+        RowId firstRow = 0;
+        size_t rowCount = 0;
+    };
+
+    enum class Status {
+        New,        // never ingested
+        Changed,    // ingested, but size or mtime differ now
+        Current     // ingested and unchanged
+    };
+
+    Status check(const std::string &path, std::uint64_t size, std::int64_t modified) const;
+
+    // Returns nullptr if path was never ingested
+    const FileEntry *find(const std::string &path) const;
+
+    void record(const std::string &path, const FileEntry &entry);
+
+    // Forget path; files whose rows came after its rows move down by its row count
+    void remove(const std::string &path);
+
+    void clear() { files.clear(); }
+    size_t size() const { return files.size(); }
+
+    const std::map<std::string, FileEntry> &getFiles() const { return files; }
+
+private:
+    std::map<std::string, FileEntry> files;
+};
+
+#endif // INGEST_MANIFEST_HPP
@@ -0,0 +1,107 @@
+#ifndef POSTING_LISTS_HPP
+#define POSTING_LISTS_HPP
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <omp.h>
+#include "AirQualityReading.hpp"
+
+// Row ids grouped by the dictionary code of one field
+using PostingLists = std::map<StringPool::Code, std::vector<RowId>>;
+
+/**
+ * Index rows [first, last) into posting lists using all OpenMP threads.
+ *
+ * Each thread groups a contiguous block of rows into its own hash table, so
+ * there is no shared state while scanning. The lists are then sized once
+ * and every key is filled in parallel, thread blocks in order, which keeps
+ * each list sorted by row id exactly as a serial build would.
+ *
+ * keyOf(row) must return the code to index row under.
+ */
+template <typename KeyOf>
+void appendPostingLists(PostingLists &index, RowId first, RowId last, KeyOf keyOf) {
+    using LocalLists = std::unordered_map<StringPool::Code, std::vector<RowId>>;
+    
+    if (first >= last) return;
+    
+    std::vector<LocalLists> local(omp_get_max_threads());
+    int numThreads = 1;
+    
+    #pragma omp parallel
+    {
+        int thread = omp_get_thread_num();
+        int threads = omp_get_num_threads();
+        
+        #pragma omp single
+        numThreads = threads;
+        
+        size_t count = last - first;
+        RowId begin = first + static_cast<RowId>(count * thread / threads);
+        RowId end = first + static_cast<RowId>(count * (thread + 1) / threads);
+        
+        LocalLists &lists = local[thread];
+        for (RowId row = begin; row < end; row++) {
+            lists[keyOf(row)].push_back(row);
+        }
+    }
+    
+    // Size every list once; remember where each key's new rows start
+    struct Slot {
+        std::vector<RowId> *rows;
+        StringPool::Code code;
+        size_t offset;
+    };
+    std::vector<Slot> slots;
+    std::unordered_map<StringPool::Code, size_t> slotOf;
+    
+    for (int thread = 0; thread < numThreads; thread++) {
+        for (const auto &pair : local[thread]) {
+            auto found = slotOf.find(pair.first);
+            if (found == slotOf.end()) {
+                slotOf.emplace(pair.first, slots.size());
+                std::vector<RowId> &rows = index[pair.first];
+                slots.push_back({&rows, pair.first, rows.size()});
+            }
+        }
+    }
+    for (const Slot &slot : slots) {
+        size_t added = 0;
+        for (int thread = 0; thread < numThreads; thread++) {
+            auto found = local[thread].find(slot.code);
+            if (found != local[thread].end()) {
+                added += found->second.size();
+            }
+        }
+        slot.rows->resize(slot.offset + added);
+    }
+    
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < slots.size(); i++) {
+        RowId *out = slots[i].rows->data() + slots[i].offset;
+        for (int thread = 0; thread < numThreads; thread++) {
+            auto found = local[thread].find(slots[i].code);
+            if (found != local[thread].end()) {
+                out = std::copy(found->second.begin(), found->second.end(), out);
+            }
+        }
+    }
+}
+
+/**
+ * Drop rows rowCount and up (the most recently appended) from posting lists.
+ *
+ * Lists are sorted by row id, so each one only loses a tail; lists left
+ * empty are erased. Costs O(keys + rows dropped).
+ */
+inline void truncatePostingLists(PostingLists &index, RowId rowCount) {
+    for (auto it = index.begin(); it != index.end();) {
+        std::vector<RowId> &rows = it->second;
+        rows.erase(std::lower_bound(rows.begin(), rows.end(), rowCount), rows.end());
+        it = rows.empty() ? index.erase(it) : std::next(it);
+    }
+}
+
+#endif // POSTING_LISTS_HPP
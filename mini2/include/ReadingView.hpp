@@ -0,0 +1,90 @@
+#ifndef READING_VIEW_HPP
+#define READING_VIEW_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "AirQualityReading.hpp"
+
+/**
+ * ReadingView - Query result that references stored readings
+ *
+ * Either a contiguous run of the store or a list of row ids into it (a
+ * posting list, an index slice, or row ids computed for this result and
+ * owned by the view). No reading is copied: iterating yields
+ * references to the manager's own readings. Call materialize() for an
+ * owning copy.
+ *
+ * Like an iterator, a view is invalidated by anything that changes the
+ * manager it came from (loads, snapshot loads, clear).
+ */
+class ReadingView {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = AirQualityReading;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const AirQualityReading *;
+        using reference = const AirQualityReading &;
+
+        Iterator(const ReadingView *view, size_t pos) : view(view), pos(pos) {}
+
+        reference operator*() const { return (*view)[pos]; }
+        pointer operator->() const { return &(*view)[pos]; }
+        Iterator &operator++() { pos++; return *this; }
+        Iterator operator++(int) { Iterator old = *this; pos++; return old; }
+        bool operator==(const Iterator &other) const { return pos == other.pos; }
+        bool operator!=(const Iterator &other) const { return pos != other.pos; }
+
+    private:
+        const ReadingView *view;
+        size_t pos;
+    };
+
+    ReadingView() = default;
+
+    // Readings [first, last) of the store
+    ReadingView(const AirQualityReading *first, const AirQualityReading *last)
+        : readings(first), count(static_cast<size_t>(last - first)) {}
+
+    // The readings at rowIds [firstRow, lastRow), in that order
+    ReadingView(const AirQualityReading *readings, const RowId *firstRow, const RowId *lastRow)
+        : readings(readings), rowIds(firstRow), count(static_cast<size_t>(lastRow - firstRow)) {}
+
+    // The readings at rowIds, which the view keeps (shared between copies)
+    ReadingView(const AirQualityReading *readings, std::vector<RowId> rowIds)
+        : readings(readings),
+          ownedRowIds(std::make_shared<const std::vector<RowId>>(std::move(rowIds))),
+          rowIds(ownedRowIds->data()), count(ownedRowIds->size()) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const AirQualityReading &operator[](size_t pos) const {
+        return rowIds ? readings[rowIds[pos]] : readings[pos];
+    }
+
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, count); }
+
+    // Owning copy, for callers that keep results past the next load
+    std::vector<AirQualityReading> materialize() const {
+        std::vector<AirQualityReading> result;
+        result.reserve(count);
+        for (size_t pos = 0; pos < count; pos++) {
+            result.push_back((*this)[pos]);
+        }
+        return result;
+    }
+
+private:
+    const AirQualityReading *readings = nullptr;
+    std::shared_ptr<const std::vector<RowId>> ownedRowIds;
+    const RowId *rowIds = nullptr;
+    size_t count = 0;
+};
+
+#endif // READING_VIEW_HPP
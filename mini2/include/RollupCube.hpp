@@ -0,0 +1,136 @@
+#ifndef ROLLUP_CUBE_HPP
+#define ROLLUP_CUBE_HPP
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "AirQualityReading.hpp"
+
+/**
+ * RollupCube - Pre-aggregated value statistics per pollutant, site and hour
+ *
+ * Every row is folded into count/sum/min/max/sum-of-squares cells as it is
+ * loaded: the (pollutant, site, hour) base cells, and the coarser rollups
+ * a report asks for - per pollutant, per (pollutant, site), and per
+ * pollutant by UTC day and by calendar month. Each question is then a
+ * single lookup instead of a pass over the rows. Rows without a timestamp
+ * count in the pollutant and site totals only.
+ *
+ * A min or max cannot be taken back out of a cell, so dropping rows means
+ * refolding - except for the rows after a checkpoint: the cells they touch
+ * are saved as they were before, and truncate() puts those back.
+ */
+class RollupCube {
+public:
+    struct Stats {
+        std::uint64_t count = 0;
+        double sum = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double sumSquares = 0.0;
+
+        void add(double value);
+        void merge(const Stats &other);
+
+        double mean() const { return count ? sum / count : 0.0; }
+        // Population variance
+        double variance() const;
+    };
+
+    // One row, as the cube sees it
+    struct Entry {
+        StringPool::Code pollutant;
+        StringPool::Code site;
+        std::int64_t timestamp;
+        double value;
+    };
+
+    /**
+     * Fold in rows added since the last call; rowCount is the new total.
+     * entryOf(row) must return the row's Entry.
+     */
+    template <typename EntryOf>
+    void update(size_t rowCount, EntryOf entryOf);
+
+    // Save the cells that rows rowCount and up change from now on, so that
+    // truncate(rowCount) can undo them; replaces the previous checkpoint.
+    // rowCount must not be below the rows folded in so far
+    void checkpoint(size_t rowCount);
+
+    // Drop the rows rowCount and up. Returns false, changing nothing, if
+    // that needs a refold (clear() and update()): rows from before the
+    // checkpoint were folded in
+    bool truncate(size_t rowCount);
+
+    void clear();
+
+    // Empty Stats (count 0) where nothing was loaded
+    Stats getTotal(StringPool::Code pollutant) const;
+    Stats getSite(StringPool::Code pollutant, StringPool::Code site) const;
+    // hourStart is a multiple of 3600 (UTC epoch seconds)
+    Stats getHour(StringPool::Code pollutant, StringPool::Code site, std::int64_t hourStart) const;
+
+    // Start of each UTC day / calendar month (epoch seconds) -> stats, in time order
+    const std::map<std::int64_t, Stats> &getDaily(StringPool::Code pollutant) const;
+    const std::map<std::int64_t, Stats> &getMonthly(StringPool::Code pollutant) const;
+
+    size_t getHourCellCount() const { return hours.size(); }
+
+    static std::int64_t monthStart(std::int64_t timestamp);
+
+private:
+    struct HourKey {
+        StringPool::Code pollutant;
+        StringPool::Code site;
+        std::int64_t hourStart;
+
+        bool operator==(const HourKey &other) const {
+            return pollutant == other.pollutant && site == other.site && hourStart == other.hourStart;
+        }
+    };
+
+    struct HourKeyHash {
+        size_t operator()(const HourKey &key) const {
+            std::uint64_t hash = (std::uint64_t(key.pollutant) << 32) ^ key.site;
+            hash ^= std::uint64_t(key.hourStart) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<size_t>(hash ^ (hash >> 29));
+        }
+    };
+
+    std::unordered_map<HourKey, Stats, HourKeyHash> hours;
+    std::unordered_map<StringPool::Code, Stats> totals;
+    std::map<std::pair<StringPool::Code, StringPool::Code>, Stats> sites;
+    std::unordered_map<StringPool::Code, std::map<std::int64_t, Stats>> daily;
+    std::unordered_map<StringPool::Code, std::map<std::int64_t, Stats>> monthly;
+    size_t foldedRows = 0;
+
+    // Cells as they were at the checkpoint, saved before the first row from
+    // checkpointRow on changed them (count 0: the cell did not exist)
+    struct Undo {
+        std::unordered_map<HourKey, Stats, HourKeyHash> hours;
+        std::unordered_map<StringPool::Code, Stats> totals;
+        std::map<std::pair<StringPool::Code, StringPool::Code>, Stats> sites;
+        std::map<std::pair<StringPool::Code, std::int64_t>, Stats> daily;
+        std::map<std::pair<StringPool::Code, std::int64_t>, Stats> monthly;
+    };
+
+    static constexpr size_t NO_CHECKPOINT = static_cast<size_t>(-1);
+
+    Undo undo;
+    size_t checkpointRow = NO_CHECKPOINT;
+
+    void add(const Entry &entry, bool saveCells);
+};
+
+template <typename EntryOf>
+void RollupCube::update(size_t rowCount, EntryOf entryOf) {
+    for (size_t row = foldedRows; row < rowCount; row++) {
+        add(entryOf(static_cast<RowId>(row)), row >= checkpointRow);
+    }
+    if (rowCount > foldedRows) {
+        foldedRows = rowCount;
+    }
+}
+
+#endif // ROLLUP_CUBE_HPP
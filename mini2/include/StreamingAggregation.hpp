@@ -0,0 +1,90 @@
+#ifndef STREAMING_AGGREGATION_HPP
+#define STREAMING_AGGREGATION_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AirQualityReading.hpp"
+#include "RollupCube.hpp"
+
+/**
+ * StreamAggregator - Partial state of one aggregate over streamed readings
+ *
+ * Each thread of a StreamingAggregation feeds its own empty copy, and the
+ * copies are merged into the registered aggregator at the end, so add()
+ * never needs locking. State must grow with the number of groups only.
+ */
+class StreamAggregator {
+public:
+    virtual ~StreamAggregator() = default;
+
+    // Aggregator of the same kind and parameters with no rows seen
+    virtual std::unique_ptr<StreamAggregator> emptyCopy() const = 0;
+
+    virtual void add(const AirQualityReading &reading) = 0;
+
+    // Fold in other, which was made by this aggregator's emptyCopy()
+    virtual void merge(const StreamAggregator &other) = 0;
+};
+
+// Count/sum/min/max of the value per pollutant
+class PollutantValueAggregator : public StreamAggregator {
+public:
+    std::unique_ptr<StreamAggregator> emptyCopy() const override;
+    void add(const AirQualityReading &reading) override;
+    void merge(const StreamAggregator &other) override;
+
+    // Empty Stats (count 0) for a pollutant never seen
+    RollupCube::Stats getStats(const std::string &pollutantType) const;
+
+private:
+    std::unordered_map<StringPool::Code, RollupCube::Stats> stats;
+};
+
+// Number of readings with AQI > threshold
+class AQIAboveCounter : public StreamAggregator {
+public:
+    explicit AQIAboveCounter(int threshold) : threshold(threshold) {}
+
+    std::unique_ptr<StreamAggregator> emptyCopy() const override;
+    void add(const AirQualityReading &reading) override;
+    void merge(const StreamAggregator &other) override;
+
+    size_t getCount() const { return count; }
+
+private:
+    int threshold;
+    size_t count = 0;
+};
+
+/**
+ * StreamingAggregation - Aggregates straight from CSV files, storing no rows
+ *
+ * For reports that need only aggregates: each file is memory-mapped and
+ * tokenized, and every reading goes to the registered aggregators and is
+ * then dropped, so memory stays proportional to the number of groups (and
+ * the strings interned for them), not to the data. Files are spread over
+ * OpenMP threads; per-thread states are merged when all files are done.
+ *
+ *   PollutantValueAggregator values;
+ *   AQIAboveCounter unhealthy(150);
+ *   StreamingAggregation stream;
+ *   stream.addAggregator(values);
+ *   stream.addAggregator(unhealthy);
+ *   stream.run(rootPath);
+ */
+class StreamingAggregation {
+public:
+    // The aggregator is not owned and must outlive run()
+    void addAggregator(StreamAggregator &aggregator);
+
+    // Stream every CSV under a root of date folders; returns readings seen
+    size_t run(const std::string &rootPath, int numThreads = 4);
+    size_t runFiles(const std::vector<std::string> &filenames, int numThreads = 4);
+
+private:
+    std::vector<StreamAggregator *> aggregators;
+};
+
+#endif // STREAMING_AGGREGATION_HPP
@@ -0,0 +1,69 @@
+#ifndef TIME_SERIES_HPP
+#define TIME_SERIES_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AirQualityDataManager.hpp"
+
+/**
+ * TimeSeries - Per-site, time-ordered readings of one pollutant
+ *
+ * Groups the pollutant's rows by fullSiteId and sorts each site's points by
+ * timestamp once, so window functions become a single pass per site:
+ * rolling mean keeps a running sum, rolling max/min keep a monotonic queue
+ * of candidates, and the EMA carries its previous value - O(n) in total,
+ * whatever the window. Sites are independent and run on separate threads.
+ *
+ * Windows are time-based, not row-based: the window ending at a point
+ * covers (timestamp - windowSeconds, timestamp], so missing hours shrink it
+ * instead of pulling in older readings. Rows without a timestamp are left
+ * out. The series is a copy; rebuild it after the manager loads more data.
+ */
+class TimeSeries {
+public:
+    struct Point {
+        std::int64_t timestamp;
+        double value;
+    };
+
+    struct Series {
+        StringPool::Code site;      // fullSiteId
+        std::vector<Point> points;  // ascending timestamp
+    };
+
+    static constexpr std::int64_t HOUR_SECONDS = 3600;
+
+    TimeSeries(const AirQualityDataManager &manager, const std::string &pollutantType, int numThreads = 4);
+
+    const std::string &getPollutantType() const { return pollutantType; }
+
+    // One series per site, ordered by fullSiteId code
+    const std::vector<Series> &getSeries() const { return series; }
+    size_t getSiteCount() const { return series.size(); }
+    size_t getPointCount() const;
+
+    // The site's raw series, or nullptr if it has no readings of the pollutant
+    const Series *findSite(const std::string &fullSiteId) const;
+
+    // Same sites and timestamps as getSeries(), each value replaced by the
+    // statistic of the window ending at that point. windowSeconds must be
+    // > 0; an empty window gives an empty result
+    std::vector<Series> rollingMean(std::int64_t windowSeconds, int numThreads = 4) const;
+    std::vector<Series> rollingMax(std::int64_t windowSeconds, int numThreads = 4) const;
+    std::vector<Series> rollingMin(std::int64_t windowSeconds, int numThreads = 4) const;
+
+    // ema = alpha * value + (1 - alpha) * previous ema, seeded with the
+    // first value; 0 < alpha <= 1
+    std::vector<Series> exponentialMovingAverage(double alpha, int numThreads = 4) const;
+
+private:
+    std::string pollutantType;
+    std::vector<Series> series;
+
+    // Apply transform(input, output) to every site, sites split across threads
+    template <typename Transform>
+    std::vector<Series> mapSeries(Transform transform, int numThreads) const;
+};
+
+#endif // TIME_SERIES_HPP
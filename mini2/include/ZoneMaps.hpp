@@ -0,0 +1,113 @@
+#ifndef ZONE_MAPS_HPP
+#define ZONE_MAPS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include <omp.h>
+#include "AirQualityReading.hpp"
+
+/**
+ * ZoneMaps - Min/max summaries of fixed-size row blocks
+ *
+ * Rows are split into blocks of BLOCK_ROWS in row id order and each block
+ * records the range of every column queries filter on. A block whose range
+ * misses a predicate cannot hold a match, so it is skipped without reading
+ * any of its rows. Rows arrive one date folder (one file per hour) at a
+ * time, so a block spans only a couple of hours.
+ */
+class ZoneMaps {
+public:
+    static constexpr size_t BLOCK_ROWS = 4096;
+
+    struct Zone {
+        int minAQI, maxAQI;
+        double minValue, maxValue;
+        std::int64_t minTimestamp, maxTimestamp;
+        double minLatitude, maxLatitude;
+        double minLongitude, maxLongitude;
+        int minCategory, maxCategory;
+
+        // Value ranges differ by orders of magnitude between pollutants, so
+        // the max is also kept per pollutant present in the block (a few)
+        std::vector<std::pair<StringPool::Code, double>> maxValueByPollutant;
+
+        // Empty range: every min above every max
+        void reset();
+        void include(int aqi, double value, std::int64_t timestamp,
+                     double latitude, double longitude, int category,
+                     StringPool::Code pollutant);
+
+        // False only when no row in the block can satisfy the predicate
+        // (ranges are inclusive, except time which is [start, end))
+        bool mayContainAQI(int low, int high) const { return maxAQI >= low && minAQI <= high; }
+        bool mayContainValue(double low, double high) const { return maxValue >= low && minValue <= high; }
+        bool mayContainTime(std::int64_t start, std::int64_t end) const { return maxTimestamp >= start && minTimestamp < end; }
+        bool mayContainCategory(int low, int high) const { return maxCategory >= low && minCategory <= high; }
+        bool mayContainPoint(double south, double north, double west, double east) const {
+            return maxLatitude >= south && minLatitude <= north &&
+                   maxLongitude >= west && minLongitude <= east;
+        }
+    };
+
+    /**
+     * Summarize rows added since the last call; rowCount is the new total.
+     * Only the last (partial) block and the new ones are recomputed, each
+     * block on its own thread. includeRow(zone, row) must widen zone by row.
+     */
+    template <typename IncludeRow>
+    void update(size_t rowCount, IncludeRow includeRow);
+
+    // Drop rows rowCount and up; the block they shared with kept rows is
+    // summarized again by the next update()
+    void truncate(size_t rowCount);
+
+    void clear();
+
+    size_t getBlockCount() const { return zones.size(); }
+    const Zone &getZone(size_t block) const { return zones[block]; }
+
+    // Rows [first, second) of a block
+    std::pair<RowId, RowId> getBlockRows(size_t block) const;
+
+    // Positions [first, second) of a sorted posting list that fall in a block
+    std::pair<size_t, size_t> findInBlock(const std::vector<RowId> &sortedRowIds, size_t block) const;
+
+    // (block, max value) for the blocks holding a pollutant, in falling order
+    // of that max: a max aggregate can stop at the first block whose max
+    // does not beat the best value found so far
+    const std::vector<std::pair<size_t, double>> &getBlocksByMaxValue(StringPool::Code pollutant) const;
+
+private:
+    std::vector<Zone> zones;
+    std::map<StringPool::Code, std::vector<std::pair<size_t, double>>> blocksByMaxValue;
+    size_t summarizedRows = 0;
+
+    void sortBlocksByMaxValue();
+};
+
+template <typename IncludeRow>
+void ZoneMaps::update(size_t rowCount, IncludeRow includeRow) {
+    if (rowCount <= summarizedRows) return;
+
+    size_t firstBlock = summarizedRows / BLOCK_ROWS;
+    zones.resize((rowCount + BLOCK_ROWS - 1) / BLOCK_ROWS);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t block = firstBlock; block < zones.size(); block++) {
+        Zone &zone = zones[block];
+        zone.reset();
+
+        size_t end = std::min(rowCount, (block + 1) * BLOCK_ROWS);
+        for (size_t row = block * BLOCK_ROWS; row < end; row++) {
+            includeRow(zone, static_cast<RowId>(row));
+        }
+    }
+
+    summarizedRows = rowCount;
+    sortBlocksByMaxValue();
+}
+
+#endif // ZONE_MAPS_HPP
@@ -0,0 +1,59 @@
+// From mini1
+#include <iostream>
+#include <filesystem>
+#include "AirQualityDataManager.hpp"
+#include "BenchMarkTimer.hpp"
+
+// Convert AirNow CSV date folders (or single files) into one binary snapshot
+//
+// Usage: csv_to_snapshot <output.aqsnap> <date folder | file.csv>...
+// e.g.   csv_to_snapshot server_c.aqsnap ../data/air_quality/202008*
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output.aqsnap> <date folder | file.csv>..." << std::endl;
+        return 1;
+    }
+    
+    std::string outputPath = argv[1];
+    AirQualityDataManager manager;
+    manager.setReadMode(CSVReadMode::MemoryMapped);
+    
+    BenchmarkTimer loadTimer;
+    loadTimer.start();
+    for (int i = 2; i < argc; i++) {
+        std::string inputPath = argv[i];
+        
+        if (std::filesystem::is_directory(inputPath)) {
+            manager.loadFromDateFolder(inputPath);
+        } else if (std::filesystem::exists(inputPath)) {
+            manager.loadFromCSV(inputPath);
+        } else {
+            std::cerr << "Warning: Skipping missing input " << inputPath << std::endl;
+        }
+    }
+    loadTimer.stop();
+    
+    std::cout << "Parsed " << manager.getReadingCount() << " readings from CSV in " 
+              << loadTimer.getMilliseconds() << " ms" << std::endl;
+    
+    if (!manager.saveSnapshot(outputPath)) {
+        return 1;
+    }
+    
+    // Read it back the way a server would at startup
+    AirQualityDataManager check;
+    BenchmarkTimer snapshotTimer;
+    snapshotTimer.start();
+    bool loaded = check.loadSnapshot(outputPath);
+    snapshotTimer.stop();
+    
+    if (!loaded || check.getReadingCount() != manager.getReadingCount()) {
+        std::cerr << "Error: Snapshot " << outputPath << " did not read back correctly" << std::endl;
+        return 1;
+    }
+    
+    std::cout << "Wrote " << outputPath << " (" << std::filesystem::file_size(outputPath) 
+              << " bytes); reloads in " << snapshotTimer.getMilliseconds() << " ms" << std::endl;
+    
+    return 0;
+}
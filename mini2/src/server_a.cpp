@@ -3,7 +3,6 @@
 #include <memory>
 #include <string>
 #include <grpcpp/grpcpp.h>
-#include <thread>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -11,6 +10,7 @@
 #include "dataserver.grpc.pb.h"
 #include "dataserver.pb.h"
 #include "CommonUtils.hpp"
+#include "ThreadPool.hpp"
 #include <chrono>
 
 using grpc::ClientContext;
@@ -89,13 +89,14 @@ public:
     
     auto team_query_start = std::chrono::high_resolution_clock::now();
     
-    std::vector<std::thread> team_threads;
+    // Team queries run on the shared pool rather than a thread per team per request
+    TaskGroup team_queries(ThreadPool::shared());
     std::mutex results_mutex;
     std::vector<std::vector<mini2::AirQualityData>> team_results;
     std::vector<long long> team_times(2);
 
     if (query == "green_data" || query == "all_data") {
-      team_threads.emplace_back([&]() {
+      team_queries.run([&]() {
         auto start = std::chrono::high_resolution_clock::now();
         Request green_req;
         green_req.set_name("green_data");
@@ -110,7 +111,7 @@ public:
     }
 
     if (query == "pink_data" || query == "all_data") {
-      team_threads.emplace_back([&]() {
+      team_queries.run([&]() {
         auto start = std::chrono::high_resolution_clock::now();
         Request pink_req;
         pink_req.set_name("pink_data");
@@ -124,9 +125,7 @@ public:
       });
     }
 
-    for (auto &thread : team_threads) {
-      thread.join();
-    }
+    team_queries.wait();
 
     auto team_query_end = std::chrono::high_resolution_clock::now();
     auto team_query_time = std::chrono::duration_cast<std::chrono::milliseconds>(
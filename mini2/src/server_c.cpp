@@ -66,24 +66,32 @@ class WorkerServiceImpl final : public DataService::Service {
   void initializeRealData() {
     std::string data_root = "../data/air_quality";
 
-    std::cout << "Server C: Loading GREEN TEAM data from August 2020 (20200801-20200831)..." << std::endl;
-
-    for (int day = 1; day <= 31; day++) {
-      std::stringstream folder_name;
-      folder_name << "202008" << std::setfill('0') << std::setw(2) << day;
-      std::string folder_path = data_root + "/" + folder_name.str();
-
-      if (std::filesystem::exists(folder_path)) {
-        dataManager_.loadFromDateFolder(folder_path);
-      } else {
-        std::cerr << "Server C: Warning: Folder not found: " << folder_path << std::endl;
+    std::string snapshot_path = "../data/snapshots/server_c.aqsnap";
+
+    // A snapshot (built with csv_to_snapshot) skips CSV parsing entirely
+    if (std::filesystem::exists(snapshot_path) && dataManager_.loadSnapshot(snapshot_path)) {
+      std::cout << "Server C: Loaded GREEN TEAM data from snapshot " << snapshot_path << std::endl;
+    } else {
+      std::cout << "Server C: Loading GREEN TEAM data from August 2020 (20200801-20200831)..." << std::endl;
+
+      for (int day = 1; day <= 31; day++) {
+        std::stringstream folder_name;
+        folder_name << "202008" << std::setfill('0') << std::setw(2) << day;
+        std::string folder_path = data_root + "/" + folder_name.str();
+
+        if (std::filesystem::exists(folder_path)) {
+          dataManager_.loadFromDateFolder(folder_path);
+        } else {
+          std::cerr << "Server C: Warning: Folder not found: " << folder_path << std::endl;
+        }
       }
     }
 
     int totalReadings = dataManager_.getReadingCount();
     std::cout << "Server C: Loaded " << totalReadings << " air quality readings from August 2020" << std::endl;
 
-    auto allReadings = dataManager_.getAllReadings();
+    ReadingView allReadings = dataManager_.getAllReadings();
+    green_team_data_["real"].reserve(allReadings.size());
     for (const auto& reading : allReadings) {
       green_team_data_["real"].push_back(CommonUtils::convertToProtobuf(reading));
     }
@@ -67,22 +67,29 @@ private:
 
 public:
   DataServiceImpl() : session_manager_(std::make_unique<SessionManager>()) {
-    std::cout << "[Server E] Loading data from Sept 1-15 (20200901 to 20200915)..." << std::endl;
     std::string data_root = "../data/air_quality";
-
-    for (int day = 1; day <= 15; day++) {
-      std::stringstream folder_name;
-      folder_name << "202009" << std::setfill('0') << std::setw(2) << day;
-      std::string folder_path = data_root + "/" + folder_name.str();
-
-      if (std::filesystem::exists(folder_path)) {
-        data_manager_.loadFromDateFolder(folder_path);
-      } else {
-        std::cerr << "[Server E] Warning: Folder not found: " << folder_path << std::endl;
+    std::string snapshot_path = "../data/snapshots/server_e.aqsnap";
+
+    // A snapshot (built with csv_to_snapshot) skips CSV parsing entirely
+    if (std::filesystem::exists(snapshot_path) && data_manager_.loadSnapshot(snapshot_path)) {
+      std::cout << "[Server E] Loaded data from snapshot " << snapshot_path << std::endl;
+    } else {
+      std::cout << "[Server E] Loading data from Sept 1-15 (20200901 to 20200915)..." << std::endl;
+
+      for (int day = 1; day <= 15; day++) {
+        std::stringstream folder_name;
+        folder_name << "202009" << std::setfill('0') << std::setw(2) << day;
+        std::string folder_path = data_root + "/" + folder_name.str();
+
+        if (std::filesystem::exists(folder_path)) {
+          data_manager_.loadFromDateFolder(folder_path);
+        } else {
+          std::cerr << "[Server E] Warning: Folder not found: " << folder_path << std::endl;
+        }
       }
     }
 
-    std::cout << "[Server E] Initialized with " << data_manager_.getAllReadings().size()
+    std::cout << "[Server E] Initialized with " << data_manager_.getReadingCount()
               << " readings from Sept 1-15" << std::endl;
   }
 
@@ -91,9 +98,11 @@ public:
 
     std::string req_id = CommonUtils::generateRequestId("req_e");
 
-    const auto &all_readings = data_manager_.getAllReadings();
+    // A view of the stored readings: nothing is copied before the protobuf conversion
+    ReadingView all_readings = data_manager_.getAllReadings();
 
     std::vector<AirQualityData> filtered_data;
+    filtered_data.reserve(all_readings.size());
     for (const auto &reading : all_readings) {
       filtered_data.push_back(CommonUtils::convertToProtobuf(reading));
     }
@@ -0,0 +1,162 @@
+// From mini1
+#include "AQIIndex.hpp"
+#include <algorithm>
+
+void AQIIndex::build(const std::vector<int> &aqiByRow) {
+    clear();
+    if (aqiByRow.empty()) return;
+
+    auto range = std::minmax_element(aqiByRow.begin(), aqiByRow.end());
+    int minValue = *range.first;
+    long long span = static_cast<long long>(*range.second) - minValue + 1;
+
+    // Map every row to its bucket: a dense table for the usual 0-500 style
+    // domain, binary search over the distinct values for anything wider
+    std::vector<size_t> bucketOf;
+    std::vector<size_t> counts;
+
+    if (span <= DENSE_SPAN_LIMIT) {
+        std::vector<size_t> valueCounts(span, 0);
+        for (int aqi : aqiByRow) {
+            valueCounts[aqi - minValue]++;
+        }
+
+        bucketOf.assign(span, 0);
+        for (long long v = 0; v < span; v++) {
+            if (valueCounts[v] > 0) {
+                bucketOf[v] = values.size();
+                values.push_back(static_cast<int>(minValue + v));
+                counts.push_back(valueCounts[v]);
+            }
+        }
+    } else {
+        values = aqiByRow;
+        std::sort(values.begin(), values.end());
+        values.erase(std::unique(values.begin(), values.end()), values.end());
+
+        counts.assign(values.size(), 0);
+        for (int aqi : aqiByRow) {
+            counts[std::lower_bound(values.begin(), values.end(), aqi) - values.begin()]++;
+        }
+    }
+
+    auto bucket = [&](int aqi) -> size_t {
+        if (!bucketOf.empty()) return bucketOf[aqi - minValue];
+        return std::lower_bound(values.begin(), values.end(), aqi) - values.begin();
+    };
+
+    // Prefix sum gives each bucket its slice; a second pass scatters row ids
+    offsets.assign(values.size() + 1, 0);
+    for (size_t i = 0; i < counts.size(); i++) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    rowIds.resize(aqiByRow.size());
+    for (size_t row = 0; row < aqiByRow.size(); row++) {
+        rowIds[next[bucket(aqiByRow[row])]++] = static_cast<RowId>(row);
+    }
+}
+
+void AQIIndex::append(RowId firstRow, const std::vector<int> &aqiByRow) {
+    if (aqiByRow.empty()) return;
+    if (rowIds.empty()) {
+        build(aqiByRow);
+        for (RowId &row : rowIds) {
+            row += firstRow;
+        }
+        return;
+    }
+
+    // Bucket the new rows on their own, then merge bucket by bucket
+    AQIIndex added;
+    added.build(aqiByRow);
+
+    std::vector<int> mergedValues;
+    std::vector<size_t> mergedOffsets(1, 0);
+    std::vector<RowId> mergedRowIds;
+    mergedValues.reserve(values.size() + added.values.size());
+    mergedOffsets.reserve(values.size() + added.values.size() + 1);
+    mergedRowIds.reserve(rowIds.size() + added.rowIds.size());
+
+    size_t oldBucket = 0;
+    size_t newBucket = 0;
+    while (oldBucket < values.size() || newBucket < added.values.size()) {
+        bool takeOld = newBucket == added.values.size() ||
+                       (oldBucket < values.size() && values[oldBucket] <= added.values[newBucket]);
+        bool takeNew = oldBucket == values.size() ||
+                       (newBucket < added.values.size() && added.values[newBucket] <= values[oldBucket]);
+
+        mergedValues.push_back(takeOld ? values[oldBucket] : added.values[newBucket]);
+
+        // Old rows first: every new row id is larger
+        if (takeOld) {
+            mergedRowIds.insert(mergedRowIds.end(), rowIds.begin() + offsets[oldBucket],
+                                rowIds.begin() + offsets[oldBucket + 1]);
+            oldBucket++;
+        }
+        if (takeNew) {
+            for (size_t pos = added.offsets[newBucket]; pos < added.offsets[newBucket + 1]; pos++) {
+                mergedRowIds.push_back(firstRow + added.rowIds[pos]);
+            }
+            newBucket++;
+        }
+        mergedOffsets.push_back(mergedRowIds.size());
+    }
+
+    values = std::move(mergedValues);
+    offsets = std::move(mergedOffsets);
+    rowIds = std::move(mergedRowIds);
+}
+
+void AQIIndex::truncate(RowId rowCount) {
+    if (rowIds.size() <= rowCount) return;
+
+    // Rows keep load order within a bucket, so the dropped ones end each slice
+    // (compacted in place: offsets[bucket + 1] is read before it is overwritten)
+    size_t kept = 0;
+    size_t keptBuckets = 0;
+    size_t begin = 0;
+    for (size_t bucket = 0; bucket < values.size(); bucket++) {
+        size_t end = offsets[bucket + 1];
+        auto first = rowIds.begin() + begin;
+        auto last = std::lower_bound(first, rowIds.begin() + end, rowCount);
+        begin = end;
+        if (first == last) continue;
+
+        kept = std::copy(first, last, rowIds.begin() + kept) - rowIds.begin();
+        values[keptBuckets] = values[bucket];
+        offsets[++keptBuckets] = kept;
+    }
+
+    values.resize(keptBuckets);
+    offsets.resize(keptBuckets + 1);
+    rowIds.resize(kept);
+}
+
+void AQIIndex::clear() {
+    values.clear();
+    offsets.clear();
+    rowIds.clear();
+}
+
+std::pair<size_t, size_t> AQIIndex::find(int minAQI, int maxAQI) const {
+    if (values.empty() || minAQI > maxAQI) return {0, 0};
+
+    size_t first = std::lower_bound(values.begin(), values.end(), minAQI) - values.begin();
+    size_t last = std::upper_bound(values.begin(), values.end(), maxAQI) - values.begin();
+
+    return {offsets[first], offsets[std::max(first, last)]};
+}
+
+size_t AQIIndex::count(int minAQI, int maxAQI) const {
+    std::pair<size_t, size_t> range = find(minAQI, maxAQI);
+    return range.second - range.first;
+}
+
+size_t AQIIndex::countAbove(int threshold) const {
+    if (values.empty()) return 0;
+
+    size_t first = std::upper_bound(values.begin(), values.end(), threshold) - values.begin();
+    return rowIds.size() - offsets[first];
+}
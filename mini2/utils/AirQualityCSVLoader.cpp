@@ -0,0 +1,465 @@
+// From mini1
+#include "AirQualityCSVLoader.hpp"
+#include "CSVParser.hpp"
+#include "CSVSchema.hpp"
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <filesystem>
+#include <fstream>
+#include <omp.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Decoded fields of one AirNow line; strings still point into the line
+struct AirQualityFields {
+    double latitude;
+    double longitude;
+    std::string_view datetime;
+    EpochSeconds timestamp{AirQualityReading::NO_TIMESTAMP};
+    std::string_view pollutantType;
+    double value;
+    std::string_view unit;
+    double rawConcentration;
+    int airQualityIndex;
+    int category;
+    std::string_view siteName;
+    std::string_view agencyName;
+    std::string_view siteId;
+    std::string_view fullSiteId;
+};
+
+// The 13-column AirNow layout; the datetime column is kept both as a string
+// and as epoch seconds. A datetime that does not parse leaves NO_TIMESTAMP
+// and the row is kept, as with the plain constructor
+using AirQualitySchema = CSVSchema<AirQualityFields,
+    Column<0, &AirQualityFields::latitude>,
+    Column<1, &AirQualityFields::longitude>,
+    Column<2, &AirQualityFields::datetime>,
+    Column<2, &AirQualityFields::timestamp, ColumnPresence::Optional>,
+    Column<3, &AirQualityFields::pollutantType>,
+    Column<4, &AirQualityFields::value>,
+    Column<5, &AirQualityFields::unit>,
+    Column<6, &AirQualityFields::rawConcentration>,
+    Column<7, &AirQualityFields::airQualityIndex>,
+    Column<8, &AirQualityFields::category>,
+    Column<9, &AirQualityFields::siteName>,
+    Column<10, &AirQualityFields::agencyName>,
+    Column<11, &AirQualityFields::siteId>,
+    Column<12, &AirQualityFields::fullSiteId>>;
+
+static_assert(AirQualitySchema::FIELD_COUNT == 13, "AirNow files have 13 columns");
+
+// Per-file (or per byte range) decoding state shared by all read paths
+class LineDecoder {
+private:
+    const std::string &filename;
+    std::function<void(const AirQualityReading &)> callback;
+    std::vector<std::string_view> fields;
+    std::vector<std::string> storage;
+    AirQualitySchema::ErrorCounts errors{};
+    int lineNumber = 0;
+    int rejected = 0;
+    
+    // (line number, field count) of lines with the wrong number of fields
+    std::vector<std::pair<int, size_t>> invalidLines;
+
+public:
+    int readingsLoaded = 0;
+    
+    LineDecoder(const std::string &filename, std::function<void(const AirQualityReading &)> callback)
+        : filename(filename), callback(std::move(callback)) {
+        fields.reserve(AirQualitySchema::FIELD_COUNT);
+    }
+    
+    void decode(std::string_view line) {
+        lineNumber++;
+        
+        if (CSVParser::isEmpty(line)) return;
+        
+        CSVParser::splitLine(line, fields, storage);
+        
+        // Check if we have all 13 fields
+        if (fields.size() != AirQualitySchema::FIELD_COUNT) {
+            invalidLines.emplace_back(lineNumber, fields.size());
+            return;
+        }
+        
+        AirQualityFields row;
+        if (!AirQualitySchema::decode(fields, row, errors)) {
+            rejected++;
+            return;
+        }
+        
+        // Strings go straight into the pool; only unseen ones are copied
+        StringPool &pool = StringPool::global();
+        AirQualityReading reading(row.latitude, row.longitude, pool.intern(row.datetime),
+                                  pool.intern(row.pollutantType), row.value, pool.intern(row.unit),
+                                  row.rawConcentration, row.airQualityIndex, row.category,
+                                  pool.intern(row.siteName), pool.intern(row.agencyName),
+                                  pool.intern(row.siteId), pool.intern(row.fullSiteId),
+                                  row.timestamp.value);
+        
+        callback(reading);
+        readingsLoaded++;
+    }
+    
+    // Append the state of the decoder for the byte range that follows this one
+    void merge(const LineDecoder &next) {
+        for (const auto &invalid : next.invalidLines) {
+            invalidLines.emplace_back(invalid.first + lineNumber, invalid.second);
+        }
+        for (size_t column = 0; column < errors.size(); column++) {
+            errors[column] += next.errors[column];
+        }
+        lineNumber += next.lineNumber;
+        rejected += next.rejected;
+        readingsLoaded += next.readingsLoaded;
+    }
+    
+    // One summary per file instead of one message per bad value
+    void reportErrors() const {
+        for (const auto &invalid : invalidLines) {
+            std::cerr << "Warning: Invalid line " << invalid.first 
+                      << " in " << filename 
+                      << " (expected 13 fields, got " << invalid.second << ")" 
+                      << std::endl;
+        }
+        
+        if (rejected == 0) return;
+        
+        std::cerr << "Warning: Skipped " << rejected << " lines with invalid values in " 
+                  << filename << " (bad values per column:";
+        for (size_t column = 0; column < errors.size(); column++) {
+            if (errors[column] > 0) {
+                std::cerr << " [" << column << "]=" << errors[column];
+            }
+        }
+        std::cerr << ")" << std::endl;
+    }
+};
+
+// A newline-aligned slice of one mapped file and the readings parsed from it
+struct ByteRangeTask {
+    size_t fileIndex;
+    size_t begin;
+    size_t end;
+    std::vector<AirQualityReading> readings;
+};
+
+// One file of a task-scheduled load: its mapping, ranges and their decoders
+struct FileLoad {
+    std::string filename;
+    std::unique_ptr<MappedFile> file;
+    std::vector<ByteRangeTask> ranges;
+    std::vector<LineDecoder> decoders;
+};
+}
+
+int AirQualityCSVLoader::loadFromCSV(
+    const std::string &filename,
+    std::function<void(const AirQualityReading &)> callback,
+    CSVReadMode mode
+) {
+    if (mode == CSVReadMode::MemoryMapped) {
+        return loadFromMappedCSV(filename, callback);
+    }
+    
+    std::ifstream file(filename);
+    
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return 0;
+    }
+    
+    LineDecoder decoder(filename, callback);
+    std::string line;
+    
+    while (std::getline(file, line)) {
+        decoder.decode(line);
+    }
+    
+    file.close();
+    decoder.reportErrors();
+    
+    return decoder.readingsLoaded;
+}
+
+int AirQualityCSVLoader::loadFromMappedCSV(
+    const std::string &filename,
+    std::function<void(const AirQualityReading &)> &callback
+) {
+    MappedFile file(filename);
+    
+    if (!file.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return 0;
+    }
+    
+    LineDecoder decoder(filename, callback);
+    std::string_view buffer = file.view();
+    size_t pos = 0;
+    
+    while (pos < buffer.length()) {
+        decoder.decode(CSVParser::nextLine(buffer, pos));
+    }
+    
+    decoder.reportErrors();
+    
+    return decoder.readingsLoaded;
+}
+
+std::vector<std::vector<AirQualityReading>> AirQualityCSVLoader::loadRangesFromCSVFiles(
+    const std::vector<std::string> &filenames,
+    int numThreads
+) {
+    if (numThreads < 1) {
+        numThreads = 1;
+    }
+    
+    // Map every file up front; the ranges below are views into these mappings
+    std::vector<MappedFile> files;
+    files.reserve(filenames.size());
+    size_t totalBytes = 0;
+    
+    for (const auto &filename : filenames) {
+        files.emplace_back(filename);
+        if (!files.back().isOpen()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+        }
+        totalBytes += files.back().size();
+    }
+    
+    // A few ranges per thread keeps dynamic scheduling balanced, but ranges
+    // stay large enough that per-range overhead is negligible
+    size_t targetBytes = std::max(MIN_RANGE_BYTES, totalBytes / (static_cast<size_t>(numThreads) * 4));
+    
+    std::vector<ByteRangeTask> tasks;
+    for (size_t i = 0; i < files.size(); i++) {
+        for (const auto &range : CSVParser::splitLineRanges(files[i].view(), targetBytes)) {
+            tasks.push_back({i, range.first, range.second, {}});
+        }
+    }
+    
+    // Each range gets its own decoder and output vector, so threads share nothing
+    std::vector<LineDecoder> decoders;
+    decoders.reserve(tasks.size());
+    for (auto &task : tasks) {
+        std::vector<AirQualityReading> *out = &task.readings;
+        decoders.emplace_back(filenames[task.fileIndex], [out](const AirQualityReading &reading) {
+            out->push_back(reading);
+        });
+    }
+    
+    #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+    for (size_t t = 0; t < tasks.size(); t++) {
+        ByteRangeTask &task = tasks[t];
+        std::string_view buffer = files[task.fileIndex].view().substr(0, task.end);
+        size_t pos = task.begin;
+        
+        task.readings.reserve((task.end - task.begin) / ESTIMATED_LINE_BYTES);
+        while (pos < buffer.length()) {
+            decoders[t].decode(CSVParser::nextLine(buffer, pos));
+        }
+    }
+    
+    // Merge each file's range decoders so warnings and line numbers are per file
+    std::vector<std::vector<AirQualityReading>> shards;
+    shards.reserve(tasks.size());
+    
+    for (size_t t = 0; t < tasks.size(); ) {
+        size_t fileIndex = tasks[t].fileIndex;
+        size_t first = t;
+        
+        for (; t < tasks.size() && tasks[t].fileIndex == fileIndex; t++) {
+            if (t > first) {
+                decoders[first].merge(decoders[t]);
+            }
+            shards.push_back(std::move(tasks[t].readings));
+        }
+        
+        decoders[first].reportErrors();
+    }
+    
+    return shards;
+}
+
+std::vector<std::vector<AirQualityReading>> AirQualityCSVLoader::loadRangesFromDirectory(
+    const std::string &rootPath,
+    ThreadPool &pool
+) {
+    namespace fs = std::filesystem;
+    
+    std::vector<fs::path> folders;
+    try {
+        for (const auto &entry : fs::directory_iterator(rootPath)) {
+            if (entry.is_directory()) {
+                folders.push_back(entry.path());
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading root directory " << rootPath 
+                  << ": " << e.what() << std::endl;
+    }
+    std::sort(folders.begin(), folders.end());
+    
+    // Every level is sized before its tasks start, so tasks write only their
+    // own slots and the result keeps folder, file, then range order
+    std::vector<std::vector<FileLoad>> loads(folders.size());
+    size_t rangesPerFile = static_cast<size_t>(pool.size()) * 2;
+    TaskGroup group(pool);
+    
+    for (size_t f = 0; f < folders.size(); f++) {
+        group.run([&, f] {
+            std::vector<std::string> filenames;
+            std::error_code error;
+            for (const auto &entry : fs::directory_iterator(folders[f], error)) {
+                if (entry.path().extension() == ".csv") {
+                    filenames.push_back(entry.path().string());
+                }
+            }
+            if (error) {
+                std::cerr << "Error reading date folder " << folders[f] 
+                          << ": " << error.message() << std::endl;
+            }
+            std::sort(filenames.begin(), filenames.end());
+            
+            std::vector<FileLoad> &files = loads[f];
+            files.resize(filenames.size());
+            for (size_t i = 0; i < files.size(); i++) {
+                files[i].filename = std::move(filenames[i]);
+                
+                group.run([&, f, i] {
+                    FileLoad &load = loads[f][i];
+                    load.file = std::make_unique<MappedFile>(load.filename);
+                    if (!load.file->isOpen()) {
+                        std::cerr << "Error: Could not open file " << load.filename << std::endl;
+                    }
+                    
+                    size_t targetBytes = std::max(MIN_RANGE_BYTES, load.file->size() / rangesPerFile);
+                    for (const auto &range : CSVParser::splitLineRanges(load.file->view(), targetBytes)) {
+                        load.ranges.push_back({i, range.first, range.second, {}});
+                    }
+                    
+                    load.decoders.reserve(load.ranges.size());
+                    for (auto &range : load.ranges) {
+                        std::vector<AirQualityReading> *out = &range.readings;
+                        load.decoders.emplace_back(load.filename, [out](const AirQualityReading &reading) {
+                            out->push_back(reading);
+                        });
+                    }
+                    
+                    for (size_t r = 0; r < load.ranges.size(); r++) {
+                        group.run([&load, r] {
+                            ByteRangeTask &range = load.ranges[r];
+                            std::string_view buffer = load.file->view().substr(0, range.end);
+                            size_t pos = range.begin;
+                            
+                            range.readings.reserve((range.end - range.begin) / ESTIMATED_LINE_BYTES);
+                            while (pos < buffer.length()) {
+                                load.decoders[r].decode(CSVParser::nextLine(buffer, pos));
+                            }
+                        });
+                    }
+                });
+            }
+        });
+    }
+    group.wait();
+    
+    // Merge each file's range decoders so warnings and line numbers are per file
+    std::vector<std::vector<AirQualityReading>> shards;
+    for (auto &files : loads) {
+        for (auto &load : files) {
+            for (size_t r = 0; r < load.ranges.size(); r++) {
+                if (r > 0) {
+                    load.decoders[0].merge(load.decoders[r]);
+                }
+                shards.push_back(std::move(load.ranges[r].readings));
+            }
+            if (!load.decoders.empty()) {
+                load.decoders[0].reportErrors();
+            }
+            load.file.reset();
+        }
+    }
+    
+    return shards;
+}
+
+int AirQualityCSVLoader::loadFromCSVFiles(
+    const std::vector<std::string> &filenames,
+    std::function<void(const AirQualityReading &)> callback,
+    int numThreads
+) {
+    int readingsLoaded = 0;
+    
+    // Ranges come back in file order, then range order: the same row order
+    // as loading the files one after another
+    for (auto &shard : loadRangesFromCSVFiles(filenames, numThreads)) {
+        for (const auto &reading : shard) {
+            callback(reading);
+        }
+        readingsLoaded += static_cast<int>(shard.size());
+        std::vector<AirQualityReading>().swap(shard);
+    }
+    
+    return readingsLoaded;
+}
+
+int AirQualityCSVLoader::loadFromDateFolder(
+    const std::string &dateFolderPath,
+    std::function<void(const AirQualityReading &)> callback,
+    CSVReadMode mode
+) {
+    namespace fs = std::filesystem;
+    int readingsLoaded = 0;
+    
+    try {
+        for (const auto &entry : fs::directory_iterator(dateFolderPath)) {
+            if (entry.path().extension() == ".csv") {
+                readingsLoaded += loadFromCSV(entry.path().string(), callback, mode);
+            }
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading date folder " << dateFolderPath 
+                  << ": " << e.what() << std::endl;
+    }
+    
+    return readingsLoaded;
+}
+
+std::vector<std::string> AirQualityCSVLoader::listCSVFiles(const std::string &rootPath) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> filenames;
+    
+    try {
+        std::vector<fs::path> folders;
+        for (const auto &entry : fs::directory_iterator(rootPath)) {
+            if (entry.is_directory()) {
+                folders.push_back(entry.path());
+            }
+        }
+        std::sort(folders.begin(), folders.end());
+        
+        for (const auto &folder : folders) {
+            std::vector<std::string> folderFiles;
+            for (const auto &entry : fs::directory_iterator(folder)) {
+                if (entry.path().extension() == ".csv") {
+                    folderFiles.push_back(entry.path().string());
+                }
+            }
+            std::sort(folderFiles.begin(), folderFiles.end());
+            filenames.insert(filenames.end(), folderFiles.begin(), folderFiles.end());
+        }
+    } catch (const fs::filesystem_error &e) {
+        std::cerr << "Error reading root directory " << rootPath 
+                  << ": " << e.what() << std::endl;
+    }
+    
+    return filenames;
+}
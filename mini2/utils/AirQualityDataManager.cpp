@@ -1,89 +1,176 @@
 // From mini1
 #include "AirQualityDataManager.hpp"
-#include "CSVParser.hpp"
-#include <fstream>
+#include "AirQualityCSVLoader.hpp"
+#include "AirQualitySnapshot.hpp"
+#include "PostingLists.hpp"
+#include "DirectoryWatcher.hpp"
+#include "ThreadPool.hpp"
 #include <iostream>
 #include <algorithm>
 #include <limits>
 #include <omp.h>
-#include <mutex>
+#include <utility>
 
-// Load data from a single CSV file
-void AirQualityDataManager::loadFromCSV(const std::string &filename) {
-    std::ifstream file(filename);
+namespace {
+
+// Keep the candidates at positions [0, count) whose readings match query;
+// rowAt(pos) is the candidate's row. In parallel, each thread filters a
+// contiguous share and the shares are joined in thread order
+template <typename RowAt>
+std::vector<RowId> filterCandidates(const std::vector<AirQualityReading> &readings,
+                                    const AirQualityQuery &query,
+                                    size_t count, RowAt rowAt, bool parallel) {
+    int maxThreads = parallel ? omp_get_max_threads() : 1;
+    std::vector<std::vector<RowId>> shares(maxThreads);
+    
+    #pragma omp parallel num_threads(maxThreads)
+    {
+        int thread = omp_get_thread_num();
+        int threads = omp_get_num_threads();
+        size_t begin = count * thread / threads;
+        size_t end = count * (thread + 1) / threads;
+        
+        std::vector<RowId> &share = shares[thread];
+        for (size_t pos = begin; pos < end; pos++) {
+            RowId row = rowAt(pos);
+            if (query.matches(readings[row])) {
+                share.push_back(row);
+            }
+        }
+    }
     
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
-        return;
+    size_t total = 0;
+    for (const auto &share : shares) {
+        total += share.size();
     }
     
-    std::string line;
-    int lineNumber = 0;
+    std::vector<RowId> result;
+    result.reserve(total);
+    for (const auto &share : shares) {
+        result.insert(result.end(), share.begin(), share.end());
+    }
+    return result;
+}
+
+}
+
+// Store a reading once and index it by row id
+void AirQualityDataManager::addReading(const AirQualityReading &reading) {
+    RowId rowId = static_cast<RowId>(readings.size());
     
-    while (std::getline(file, line)) {
-        lineNumber++;
-        
-        if (CSVParser::isEmpty(line)) continue;
-        
-        std::vector<std::string> fields = CSVParser::parseLine(line);
-        
-        // Check if we have all 13 fields
-        if (fields.size() != 13) {
-            std::cerr << "Warning: Invalid line " << lineNumber 
-                      << " in " << filename 
-                      << " (expected 13 fields, got " << fields.size() << ")" 
-                      << std::endl;
-            continue;
-        }
-        
-        try {
-            // Extract and convert fields
-            double lat = std::stod(fields[0]);
-            double lon = std::stod(fields[1]);
-            std::string datetime = fields[2];
-            std::string pollutant = fields[3];
-            double value = std::stod(fields[4]);
-            std::string unit = fields[5];
-            double rawConc = std::stod(fields[6]);
-            int aqi = std::stoi(fields[7]);
-            int category = std::stoi(fields[8]);
-            std::string siteName = fields[9];
-            std::string agency = fields[10];
-            std::string siteId = fields[11];
-            std::string fullSiteId = fields[12];
-            
-            // Create the reading object
-            AirQualityReading reading(lat, lon, datetime, pollutant, value, unit,
-                                      rawConc, aqi, category, siteName, agency,
-                                      siteId, fullSiteId);
-            
-            // Add to all three containers
-            readings.push_back(reading);
-            readingsByDate[datetime].push_back(reading);
-            readingsByPollutant[pollutant].push_back(reading);
-            
-        } catch (const std::exception &e) {
-            std::cerr << "Error parsing line " << lineNumber 
-                      << " in " << filename << ": " << e.what() << std::endl;
-            continue;
+    readings.push_back(reading);
+    readingsByDate[reading.getDatetimeCode()].push_back(rowId);
+    readingsByPollutant[reading.getPollutantTypeCode()].push_back(rowId);
+}
+
+// View the readings behind positions [first, last) of a posting list or index
+ReadingView AirQualityDataManager::viewRows(const std::vector<RowId> &rowIds, size_t first, size_t last) const {
+    return ReadingView(readings.data(), rowIds.data() + first, rowIds.data() + last);
+}
+
+// Move shards into one allocation sized by a prefix sum, then index the
+// new rows in parallel; no thread ever waits on another's merge
+void AirQualityDataManager::appendShards(std::vector<std::vector<AirQualityReading>> &shards) {
+    std::vector<size_t> offsets(shards.size() + 1);
+    offsets[0] = readings.size();
+    for (size_t i = 0; i < shards.size(); i++) {
+        offsets[i + 1] = offsets[i] + shards[i].size();
+    }
+    
+    readings.resize(offsets.back());
+    
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::move(shards[i].begin(), shards[i].end(), readings.begin() + offsets[i]);
+        std::vector<AirQualityReading>().swap(shards[i]);
+    }
+    
+    RowId first = static_cast<RowId>(offsets.front());
+    RowId last = static_cast<RowId>(offsets.back());
+    appendPostingLists(readingsByDate, first, last, [this](RowId rowId) {
+        return readings[rowId].getDatetimeCode();
+    });
+    appendPostingLists(readingsByPollutant, first, last, [this](RowId rowId) {
+        return readings[rowId].getPollutantTypeCode();
+    });
+    updateIndexes();
+}
+
+// Bring the time, AQI and spatial indexes, the zone maps and the rollups up to date with rows added since the last call
+void AirQualityDataManager::updateIndexes() {
+    std::vector<std::pair<std::int64_t, RowId>> entries;
+    entries.reserve(readings.size() - timeIndexedRows);
+    
+    for (size_t row = timeIndexedRows; row < readings.size(); row++) {
+        std::int64_t timestamp = readings[row].getTimestamp();
+        if (timestamp != AirQualityReading::NO_TIMESTAMP) {
+            entries.emplace_back(timestamp, static_cast<RowId>(row));
         }
     }
     
-    file.close();
+    timeIndex.append(std::move(entries));
+    timeIndexedRows = readings.size();
+    
+    // Only the new rows are counting-sorted, then merged into the buckets
+    RowId firstNew = static_cast<RowId>(aqiIndex.size());
+    std::vector<int> aqiByRow(readings.size() - firstNew);
+    for (size_t row = firstNew; row < readings.size(); row++) {
+        aqiByRow[row - firstNew] = readings[row].getAirQualityIndex();
+    }
+    aqiIndex.append(firstNew, aqiByRow);
+    
+    zoneMaps.update(readings.size(), [this](ZoneMaps::Zone &zone, RowId row) {
+        const AirQualityReading &reading = readings[row];
+        zone.include(reading.getAirQualityIndex(), reading.getValue(), reading.getTimestamp(),
+                     reading.getLatitude(), reading.getLongitude(), reading.getCategory(),
+                     reading.getPollutantTypeCode());
+    });
+    
+    spatialIndex.update(readings.size(), [this](RowId row) {
+        const AirQualityReading &reading = readings[row];
+        return SpatialIndex::Point{reading.getLatitude(), reading.getLongitude(), reading.getFullSiteIdCode()};
+    });
+    
+    if (rollupsEnabled) {
+        updateRollups();
+    }
+}
+
+void AirQualityDataManager::updateRollups() {
+    rollups.update(readings.size(), [this](RowId row) {
+        const AirQualityReading &reading = readings[row];
+        return RollupCube::Entry{reading.getPollutantTypeCode(), reading.getFullSiteIdCode(),
+                                 reading.getTimestamp(), reading.getValue()};
+    });
+}
+
+void AirQualityDataManager::setRollupsEnabled(bool enabled) {
+    rollupsEnabled = enabled;
+    if (enabled) {
+        updateRollups();
+    } else {
+        rollups.clear();
+    }
+}
+
+const RollupCube &AirQualityDataManager::getRollups() const {
+    return rollups;
+}
+
+// Load data from a single CSV file
+void AirQualityDataManager::loadFromCSV(const std::string &filename) {
+    AirQualityCSVLoader::loadFromCSV(filename, [this](const AirQualityReading &reading) {
+        addReading(reading);
+    }, readMode);
+    updateIndexes();
 }
 
 // Load all CSV files from a date folder
 void AirQualityDataManager::loadFromDateFolder(const std::string &dateFolderPath) {
-    try {
-        for (const auto &entry : fs::directory_iterator(dateFolderPath)) {
-            if (entry.path().extension() == ".csv") {
-                loadFromCSV(entry.path().string());
-            }
-        }
-    } catch (const fs::filesystem_error &e) {
-        std::cerr << "Error reading date folder " << dateFolderPath 
-                  << ": " << e.what() << std::endl;
-    }
+    AirQualityCSVLoader::loadFromDateFolder(dateFolderPath, [this](const AirQualityReading &reading) {
+        addReading(reading);
+    }, readMode);
+    updateIndexes();
 }
 
 // Load all date folders from root directory
@@ -101,16 +188,151 @@ void AirQualityDataManager::loadFromDirectory(const std::string &rootPath) {
     }
 }
 
+// Write the loaded state to a binary snapshot
+bool AirQualityDataManager::saveSnapshot(const std::string &path) const {
+    return AirQualitySnapshot::write(path, readings, readingsByDate, readingsByPollutant, timeIndex);
+}
+
+// Replace the loaded state with a binary snapshot
+bool AirQualityDataManager::loadSnapshot(const std::string &path) {
+    bool loaded = AirQualitySnapshot::read(path, readings, readingsByDate, readingsByPollutant, timeIndex);
+    
+    // Every row was replaced, so summarize all blocks again
+    timeIndexedRows = readings.size();
+    aqiIndex.clear();
+    zoneMaps.clear();
+    spatialIndex.clear();
+    rollups.clear();
+    manifest.clear();
+    updateIndexes();
+    return loaded;
+}
+
+// Drop rows [first, last) and index the remaining rows from scratch (no
+// CSV is parsed again); later rows move down, so views become invalid
+void AirQualityDataManager::removeRows(RowId first, RowId last) {
+    readings.erase(readings.begin() + first, readings.begin() + last);
+    
+    readingsByDate.clear();
+    readingsByPollutant.clear();
+    appendPostingLists(readingsByDate, 0, static_cast<RowId>(readings.size()), [this](RowId rowId) {
+        return readings[rowId].getDatetimeCode();
+    });
+    appendPostingLists(readingsByPollutant, 0, static_cast<RowId>(readings.size()), [this](RowId rowId) {
+        return readings[rowId].getPollutantTypeCode();
+    });
+    
+    timeIndex.clear();
+    timeIndexedRows = 0;
+    aqiIndex.clear();
+    zoneMaps.clear();
+    spatialIndex.clear();
+    rollups.clear();
+    updateIndexes();
+}
+
+// Drop rows first and up in place: every index sheds only those rows, and
+// the next updateIndexes() extends them again as after any load
+void AirQualityDataManager::truncateRows(RowId first) {
+    readings.erase(readings.begin() + first, readings.end());
+    
+    truncatePostingLists(readingsByDate, first);
+    truncatePostingLists(readingsByPollutant, first);
+    
+    timeIndex.truncate(first);
+    timeIndexedRows = std::min(timeIndexedRows, static_cast<size_t>(first));
+    aqiIndex.truncate(first);
+    zoneMaps.truncate(first);
+    spatialIndex.truncate(first);
+    
+    // Only rows after the rollup checkpoint can be taken back out of the cube
+    if (!rollups.truncate(first)) {
+        rollups.clear();
+    }
+}
+
+// Load new and rewritten CSV files under rootPath, as told by the manifest
+size_t AirQualityDataManager::ingestNewFiles(const std::string &rootPath) {
+    size_t filesRead = 0;
+    
+    for (const std::string &filename : AirQualityCSVLoader::listCSVFiles(rootPath)) {
+        std::error_code sizeError;
+        std::error_code timeError;
+        std::uint64_t size = fs::file_size(filename, sizeError);
+        std::int64_t modified = fs::last_write_time(filename, timeError).time_since_epoch().count();
+        if (sizeError || timeError) {
+            std::error_code error = sizeError ? sizeError : timeError;
+            std::cerr << "Error: cannot stat " << filename << ": " << error.message() << std::endl;
+            continue;
+        }
+        
+        IngestManifest::Status status = manifest.check(filename, size, modified);
+        if (status == IngestManifest::Status::Current) continue;
+        
+        // A rewritten file (e.g. the current hour growing) replaces its old rows.
+        // That is usually the last file loaded, whose rows are the tail
+        if (status == IngestManifest::Status::Changed) {
+            const IngestManifest::FileEntry *old = manifest.find(filename);
+            RowId first = old->firstRow;
+            RowId last = first + static_cast<RowId>(old->rowCount);
+            manifest.remove(filename);
+            if (last == readings.size()) {
+                truncateRows(first);
+            } else {
+                removeRows(first, last);
+            }
+        }
+        
+        IngestManifest::FileEntry entry;
+        entry.size = size;
+        entry.modified = modified;
+        entry.firstRow = static_cast<RowId>(readings.size());
+        rollups.checkpoint(entry.firstRow);
+        AirQualityCSVLoader::loadFromCSV(filename, [this](const AirQualityReading &reading) {
+            addReading(reading);
+        }, readMode);
+        entry.rowCount = readings.size() - entry.firstRow;
+        
+        manifest.record(filename, entry);
+        filesRead++;
+    }
+    
+    if (filesRead > 0) {
+        updateIndexes();
+    }
+    return filesRead;
+}
+
+// Ingest whenever the watcher reports new or rewritten files
+void AirQualityDataManager::watchDirectory(const std::string &rootPath, 
+                                           const std::function<bool(size_t)> &onIngest,
+                                           int timeoutMillis) {
+    // Watch before the first scan so no file can land unseen in between
+    DirectoryWatcher watcher(rootPath);
+    
+    size_t filesRead = ingestNewFiles(rootPath);
+    while (onIngest(filesRead)) {
+        filesRead = watcher.waitForChange(timeoutMillis) ? ingestNewFiles(rootPath) : 0;
+    }
+}
+
 // Clear all data
 void AirQualityDataManager::clear() {
     readings.clear();
     readingsByDate.clear();
     readingsByPollutant.clear();
+    timeIndex.clear();
+    timeIndexedRows = 0;
+    aqiIndex.clear();
+    zoneMaps.clear();
+    spatialIndex.clear();
+    rollups.clear();
+    manifest.clear();
 }
 
 // Get all readings
-std::vector<AirQualityReading> AirQualityDataManager::getAllReadings() const {
-    return readings;
+ReadingView AirQualityDataManager::getAllReadings() const {
+    return ReadingView(readings.data(), readings.data() + readings.size());
 }
 
 // Get count of readings
@@ -119,64 +341,212 @@ int AirQualityDataManager::getReadingCount() const {
 }
 
 // Get readings by date (uses index - fast!)
-std::vector<AirQualityReading> AirQualityDataManager::getReadingsByDate(const std::string &date) const {
-    auto it = readingsByDate.find(date);
-    if (it != readingsByDate.end()) {
-        return it->second;
-    }
-    return std::vector<AirQualityReading>();  // Empty vector if not found
+ReadingView AirQualityDataManager::getReadingsByDate(const std::string &date) const {
+    const std::vector<RowId> &rowIds = getRowIdsByDate(date);
+    return viewRows(rowIds, 0, rowIds.size());
 }
 
 // Get readings by pollutant type (uses index - fast!)
-std::vector<AirQualityReading> AirQualityDataManager::getReadingsByPollutant(const std::string &pollutantType) const {
-    auto it = readingsByPollutant.find(pollutantType);
-    if (it != readingsByPollutant.end()) {
-        return it->second;
+ReadingView AirQualityDataManager::getReadingsByPollutant(const std::string &pollutantType) const {
+    const std::vector<RowId> &rowIds = getRowIdsByPollutant(pollutantType);
+    return viewRows(rowIds, 0, rowIds.size());
+}
+
+// Get the posting list for a date (no readings are copied)
+const std::vector<RowId> &AirQualityDataManager::getRowIdsByDate(const std::string &date) const {
+    static const std::vector<RowId> empty;
+    auto it = readingsByDate.find(StringPool::global().find(date));
+    return it != readingsByDate.end() ? it->second : empty;
+}
+
+// Get the posting list for a pollutant type (no readings are copied)
+const std::vector<RowId> &AirQualityDataManager::getRowIdsByPollutant(const std::string &pollutantType) const {
+    static const std::vector<RowId> empty;
+    auto it = readingsByPollutant.find(StringPool::global().find(pollutantType));
+    return it != readingsByPollutant.end() ? it->second : empty;
+}
+
+// Get a stored reading by row id
+const AirQualityReading &AirQualityDataManager::getReadingAt(RowId rowId) const {
+    return readings[rowId];
+}
+
+// Get readings with start <= timestamp < end from the time index
+ReadingView AirQualityDataManager::getReadingsByTimeRange(std::int64_t start, std::int64_t end) const {
+    std::pair<size_t, size_t> range = timeIndex.find(start, end);
+    return viewRows(timeIndex.getRowIds(), range.first, range.second);
+}
+
+const TimeIndex &AirQualityDataManager::getTimeIndex() const {
+    return timeIndex;
+}
+
+// Get readings within an AQI range from the AQI index (grouped by AQI value)
+ReadingView AirQualityDataManager::getReadingsByAQIRange(int minAQI, int maxAQI) const {
+    std::pair<size_t, size_t> range = aqiIndex.find(minAQI, maxAQI);
+    return viewRows(aqiIndex.getRowIds(), range.first, range.second);
+}
+
+// Choose the access path with the fewest candidate rows. Index slices are
+// sized exactly by a lookup or two binary searches; a zone scan reads every
+// row of the blocks whose zone maps do not rule the query out
+QueryPlan AirQualityDataManager::planQuery(const AirQualityQuery &query) const {
+    QueryPlan plan;
+    for (size_t block = 0; block < zoneMaps.getBlockCount(); block++) {
+        if (query.mayMatch(zoneMaps.getZone(block))) {
+            std::pair<RowId, RowId> rows = zoneMaps.getBlockRows(block);
+            plan.candidateRows += rows.second - rows.first;
+        }
+    }
+    
+    auto consider = [&plan](QueryPlan::Access access, size_t candidateRows) {
+        if (candidateRows < plan.candidateRows) {
+            plan.access = access;
+            plan.candidateRows = candidateRows;
+        }
+    };
+    
+    if (query.pollutantCode) {
+        auto it = readingsByPollutant.find(*query.pollutantCode);
+        consider(QueryPlan::Access::PollutantIndex, it != readingsByPollutant.end() ? it->second.size() : 0);
+    }
+    if (query.time) {
+        std::pair<size_t, size_t> range = timeIndex.find(query.time->first, query.time->second);
+        consider(QueryPlan::Access::TimeIndex, range.second - range.first);
+    }
+    if (query.aqi) {
+        consider(QueryPlan::Access::AQIIndex, aqiIndex.count(query.aqi->first, query.aqi->second));
     }
-    return std::vector<AirQualityReading>();  // Empty vector if not found
+    if (query.box) {
+        consider(QueryPlan::Access::SpatialIndex, spatialIndex.countCandidates(*query.box));
+    }
+    
+    return plan;
 }
 
-// Get readings within an AQI range (needs to scan all, good for benchmarking)
-std::vector<AirQualityReading> AirQualityDataManager::getReadingsByAQIRange(int minAQI, int maxAQI) const {
-    std::vector<AirQualityReading> result;
+// Run a query along its plan, serially or with all threads
+std::vector<RowId> AirQualityDataManager::runQuery(const AirQualityQuery &query, bool parallel) const {
+    QueryPlan plan = planQuery(query);
+    if (plan.candidateRows == 0) {
+        return std::vector<RowId>();
+    }
     
-    for (const auto &reading : readings) {
-        int aqi = reading.getAirQualityIndex();
-        if (aqi >= minAQI && aqi <= maxAQI) {
-            result.push_back(reading);
+    // The driving predicate holds for every candidate; check only the rest
+    AirQualityQuery residual = query;
+    const RowId *slice = nullptr;
+    std::vector<size_t> blocks;
+    std::vector<RowId> cellRows;
+    
+    switch (plan.access) {
+        case QueryPlan::Access::PollutantIndex:
+            residual.pollutantCode.reset();
+            slice = readingsByPollutant.at(*query.pollutantCode).data();
+            break;
+        case QueryPlan::Access::TimeIndex: {
+            residual.time.reset();
+            std::pair<size_t, size_t> range = timeIndex.find(query.time->first, query.time->second);
+            slice = timeIndex.getRowIds().data() + range.first;
+            break;
         }
+        case QueryPlan::Access::AQIIndex: {
+            residual.aqi.reset();
+            std::pair<size_t, size_t> range = aqiIndex.find(query.aqi->first, query.aqi->second);
+            slice = aqiIndex.getRowIds().data() + range.first;
+            break;
+        }
+        case QueryPlan::Access::SpatialIndex:
+            // Border cells overhang the box, so the box stays in the residual
+            cellRows = spatialIndex.findCandidates(*query.box);
+            slice = cellRows.data();
+            break;
+        case QueryPlan::Access::ZoneScan:
+            for (size_t block = 0; block < zoneMaps.getBlockCount(); block++) {
+                if (query.mayMatch(zoneMaps.getZone(block))) {
+                    blocks.push_back(block);
+                }
+            }
+            break;
+    }
+    
+    // Scan candidates are the rows of the kept blocks back to back; only the
+    // store's last block can be partial, and it is also the last one kept
+    auto rowAt = [&](size_t pos) {
+        if (slice) return slice[pos];
+        return static_cast<RowId>(blocks[pos / ZoneMaps::BLOCK_ROWS] * ZoneMaps::BLOCK_ROWS + pos % ZoneMaps::BLOCK_ROWS);
+    };
+    
+    std::vector<RowId> result = filterCandidates(readings, residual, plan.candidateRows, rowAt, parallel);
+    
+    // Time and AQI slices are ordered by their key and grid rows by cell, not by row
+    if (plan.access == QueryPlan::Access::TimeIndex || plan.access == QueryPlan::Access::AQIIndex ||
+        plan.access == QueryPlan::Access::SpatialIndex) {
+        std::sort(result.begin(), result.end());
     }
     
     return result;
 }
 
+// Rows matching every predicate of a query
+std::vector<RowId> AirQualityDataManager::selectRows(const AirQualityQuery &query) const {
+    return runQuery(query, false);
+}
+
+// View the readings behind a row id list (e.g. a query result)
+ReadingView AirQualityDataManager::getReadingsAt(const std::vector<RowId> &rowIds) const {
+    return viewRows(rowIds, 0, rowIds.size());
+}
+
+// Get readings inside a lat/lon box (planned like any query, usually on the grid)
+ReadingView AirQualityDataManager::getReadingsInBoundingBox(double south, double north, double west, double east) const {
+    return ReadingView(readings.data(), selectRows(AirQualityQuery().boundingBox(south, north, west, east)));
+}
+
+// Get the k sites nearest a point from the spatial grid
+std::vector<SpatialIndex::SiteDistance> AirQualityDataManager::getNearestSites(double latitude, double longitude, size_t k) const {
+    return spatialIndex.findNearestSites(latitude, longitude, k);
+}
+
 // Calculate average pollutant value (good for parallelization tests!)
 double AirQualityDataManager::getAveragePollutantValue(const std::string &pollutantType) const {
-    auto pollutantReadings = getReadingsByPollutant(pollutantType);
+    if (rollupsEnabled) {
+        return rollups.getTotal(StringPool::global().find(pollutantType)).mean();
+    }
+    
+    const auto &rowIds = getRowIdsByPollutant(pollutantType);
     
-    if (pollutantReadings.empty()) {
+    if (rowIds.empty()) {
         return 0.0;
     }
     
     double sum = 0.0;
-    for (const auto &reading : pollutantReadings) {
-        sum += reading.getValue();
+    for (RowId rowId : rowIds) {
+        sum += readings[rowId].getValue();
     }
     
-    return sum / pollutantReadings.size();
+    return sum / rowIds.size();
 }
 
-// Get maximum pollutant value
+// Get maximum pollutant value, skipping blocks whose max cannot beat the best so far
 double AirQualityDataManager::getMaxPollutantValue(const std::string &pollutantType) const {
-    auto pollutantReadings = getReadingsByPollutant(pollutantType);
+    if (rollupsEnabled) {
+        return rollups.getTotal(StringPool::global().find(pollutantType)).max;
+    }
+    
+    const std::vector<RowId> &rowIds = getRowIdsByPollutant(pollutantType);
     
-    if (pollutantReadings.empty()) {
+    if (rowIds.empty()) {
         return 0.0;
     }
     
     double maxValue = std::numeric_limits<double>::lowest();
-    for (const auto &reading : pollutantReadings) {
-        maxValue = std::max(maxValue, reading.getValue());
+    for (const auto &block : zoneMaps.getBlocksByMaxValue(StringPool::global().find(pollutantType))) {
+        // Blocks come in falling order of their max, so no later block can win
+        if (block.second <= maxValue) break;
+        
+        std::pair<size_t, size_t> slice = zoneMaps.findInBlock(rowIds, block.first);
+        for (size_t pos = slice.first; pos < slice.second; pos++) {
+            maxValue = std::max(maxValue, readings[rowIds[pos]].getValue());
+        }
     }
     
     return maxValue;
@@ -184,15 +554,21 @@ double AirQualityDataManager::getMaxPollutantValue(const std::string &pollutantT
 
 // Count readings above an AQI threshold
 int AirQualityDataManager::countReadingsAboveAQI(int threshold) const {
-    int count = 0;
-    
-    for (const auto &reading : readings) {
-        if (reading.getAirQualityIndex() > threshold) {
-            count++;
-        }
-    }
-    
-    return count;
+    return static_cast<int>(aqiIndex.countAbove(threshold));
+}
+
+// Statistics per group in one serial scan
+std::vector<GroupBy::Row> AirQualityDataManager::groupBy(unsigned columns) const {
+    return GroupBy::aggregate(readings.size(), columns, [this](RowId row) -> const AirQualityReading & {
+        return readings[row];
+    }, 1);
+}
+
+// Statistics per group, thread-local tables merged at the end
+std::vector<GroupBy::Row> AirQualityDataManager::groupByParallel(unsigned columns) const {
+    return GroupBy::aggregate(readings.size(), columns, [this](RowId row) -> const AirQualityReading & {
+        return readings[row];
+    }, omp_get_max_threads());
 }
 
 // Get all unique dates
@@ -200,9 +576,11 @@ std::vector<std::string> AirQualityDataManager::getAllDates() const {
     std::vector<std::string> dates;
     
     for (const auto &pair : readingsByDate) {
-        dates.push_back(pair.first);
+        dates.push_back(StringPool::global().get(pair.first));
     }
     
+    // Codes follow load order, so restore lexical order
+    std::sort(dates.begin(), dates.end());
     return dates;
 }
 
@@ -211,117 +589,115 @@ std::vector<std::string> AirQualityDataManager::getAllPollutantTypes() const {
     std::vector<std::string> types;
     
     for (const auto &pair : readingsByPollutant) {
-        types.push_back(pair.first);
+        types.push_back(StringPool::global().get(pair.first));
     }
     
+    // Codes follow load order, so restore lexical order
+    std::sort(types.begin(), types.end());
     return types;
 }
 
-// Parallel loading of directory
+// Parallel loading of directory on a pool of its own
 void AirQualityDataManager::loadFromDirectoryParallel(const std::string &rootPath, int numThreads) {
-    // Set number of threads
-    omp_set_num_threads(numThreads);
-    
-    // Get all folder paths first
-    std::vector<std::string> folderPaths;
-    try {
-        for (const auto &entry : fs::directory_iterator(rootPath)) {
-            if (entry.is_directory()) {
-                folderPaths.push_back(entry.path().string());
-            }
-        }
-    } catch (const fs::filesystem_error &e) {
-        std::cerr << "Error reading root directory " << rootPath 
-                  << ": " << e.what() << std::endl;
-        return;
-    }
-    
-    // Mutex for thread-safe container access
-    std::mutex dataMutex;
+    ThreadPool pool(static_cast<unsigned>(std::max(numThreads, 1)));
+    loadFromDirectoryParallel(rootPath, pool);
+}
+
+// Folder, file and byte-range tasks on a work-stealing pool
+void AirQualityDataManager::loadFromDirectoryParallel(const std::string &rootPath, ThreadPool &pool) {
+    auto shards = AirQualityCSVLoader::loadRangesFromDirectory(rootPath, pool);
     
-    // Parallel loading
-    #pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < folderPaths.size(); i++) {
-        std::cout << "Thread " << omp_get_thread_num() 
-                  << " loading: " << fs::path(folderPaths[i]).filename() << std::endl;
-        
-        // Create temporary manager for this thread
-        AirQualityDataManager tempManager;
-        tempManager.loadFromDateFolder(folderPaths[i]);
-        
-        // Merge into main manager (critical section)
-        #pragma omp critical
-        {
-            auto tempReadings = tempManager.getAllReadings();
-            for (const auto &reading : tempReadings) {
-                readings.push_back(reading);
-                readingsByDate[reading.getDatetime()].push_back(reading);
-                readingsByPollutant[reading.getPollutantType()].push_back(reading);
-            }
-        }
-    }
+    // Shards are in folder, file, then range order: rows match a serial load of sorted files
+    appendShards(shards);
+}
+
+// Parse one file with all threads, each taking a newline-aligned byte range
+void AirQualityDataManager::loadFromCSVParallel(const std::string &filename, int numThreads) {
+    auto shards = AirQualityCSVLoader::loadRangesFromCSVFiles({filename}, numThreads);
+    appendShards(shards);
 }
 
-// Parallel range query
+// Parallel loading that splits files into byte ranges, so the thread count
+// is not capped by the number of date folders
+void AirQualityDataManager::loadFromDirectoryByteRanges(const std::string &rootPath, int numThreads) {
+    loadFromCSVFiles(AirQualityCSVLoader::listCSVFiles(rootPath), numThreads);
+}
+
+// Byte-range parallel loading of an explicit list of files, in list order
+void AirQualityDataManager::loadFromCSVFiles(const std::vector<std::string> &filenames, int numThreads) {
+    auto shards = AirQualityCSVLoader::loadRangesFromCSVFiles(filenames, numThreads);
+    appendShards(shards);
+}
+
+// Parallel range query: an owning copy of the AQI range, gathered by all threads
 std::vector<AirQualityReading> AirQualityDataManager::getReadingsByAQIRangeParallel(int minAQI, int maxAQI) const {
-    std::vector<AirQualityReading> result;
-    std::mutex resultMutex;
+    std::pair<size_t, size_t> range = aqiIndex.find(minAQI, maxAQI);
+    const std::vector<RowId> &rowIds = aqiIndex.getRowIds();
     
-    #pragma omp parallel
-    {
-        std::vector<AirQualityReading> localResult;
-        
-        #pragma omp for nowait
-        for (size_t i = 0; i < readings.size(); i++) {
-            int aqi = readings[i].getAirQualityIndex();
-            if (aqi >= minAQI && aqi <= maxAQI) {
-                localResult.push_back(readings[i]);
-            }
-        }
-        
-        // Merge local results
-        #pragma omp critical
-        {
-            result.insert(result.end(), localResult.begin(), localResult.end());
-        }
+    // The slice size is known up front, so threads gather into disjoint slots
+    std::vector<AirQualityReading> result(range.second - range.first);
+    
+    #pragma omp parallel for
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i] = readings[rowIds[range.first + i]];
     }
     
     return result;
 }
 
+// Parallel query: candidates are split across threads for the fused filter
+std::vector<RowId> AirQualityDataManager::selectRowsParallel(const AirQualityQuery &query) const {
+    return runQuery(query, true);
+}
+
 // Parallel average calculation
 double AirQualityDataManager::getAveragePollutantValueParallel(const std::string &pollutantType) const {
-    auto pollutantReadings = getReadingsByPollutant(pollutantType);
+    if (rollupsEnabled) {
+        return rollups.getTotal(StringPool::global().find(pollutantType)).mean();
+    }
     
-    if (pollutantReadings.empty()) {
+    const auto &rowIds = getRowIdsByPollutant(pollutantType);
+    
+    if (rowIds.empty()) {
         return 0.0;
     }
     
     double sum = 0.0;
     
     #pragma omp parallel for reduction(+:sum)
-    for (size_t i = 0; i < pollutantReadings.size(); i++) {
-        sum += pollutantReadings[i].getValue();
+    for (size_t i = 0; i < rowIds.size(); i++) {
+        sum += readings[rowIds[i]].getValue();
     }
     
-    return sum / pollutantReadings.size();
+    return sum / rowIds.size();
 }
 
 // Parallel max calculation
 double AirQualityDataManager::getMaxPollutantValueParallel(const std::string &pollutantType) const {
-    auto pollutantReadings = getReadingsByPollutant(pollutantType);
+    if (rollupsEnabled) {
+        return rollups.getTotal(StringPool::global().find(pollutantType)).max;
+    }
+    
+    const std::vector<RowId> &rowIds = getRowIdsByPollutant(pollutantType);
     
-    if (pollutantReadings.empty()) {
+    if (rowIds.empty()) {
         return 0.0;
     }
     
+    const std::vector<std::pair<size_t, double>> &blocks =
+        zoneMaps.getBlocksByMaxValue(StringPool::global().find(pollutantType));
     double maxValue = std::numeric_limits<double>::lowest();
     
-    #pragma omp parallel for reduction(max:maxValue)
-    for (size_t i = 0; i < pollutantReadings.size(); i++) {
-        double val = pollutantReadings[i].getValue();
-        if (val > maxValue) {
-            maxValue = val;
+    // Round-robin over the max-ordered blocks so every thread starts with a
+    // promising block; each then prunes against its own best (the private
+    // reduction copy), which only ever costs some extra blocks
+    #pragma omp parallel for schedule(static, 1) reduction(max:maxValue)
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (blocks[i].second <= maxValue) continue;
+        
+        std::pair<size_t, size_t> slice = zoneMaps.findInBlock(rowIds, blocks[i].first);
+        for (size_t pos = slice.first; pos < slice.second; pos++) {
+            maxValue = std::max(maxValue, readings[rowIds[pos]].getValue());
         }
     }
     
@@ -330,14 +706,6 @@ double AirQualityDataManager::getMaxPollutantValueParallel(const std::string &po
 
 // Parallel count
 int AirQualityDataManager::countReadingsAboveAQIParallel(int threshold) const {
-    int count = 0;
-    
-    #pragma omp parallel for reduction(+:count)
-    for (size_t i = 0; i < readings.size(); i++) {
-        if (readings[i].getAirQualityIndex() > threshold) {
-            count++;
-        }
-    }
-    
-    return count;
+    // A bucket-offset difference; nothing left to split across threads
+    return static_cast<int>(aqiIndex.countAbove(threshold));
 }
\ No newline at end of file
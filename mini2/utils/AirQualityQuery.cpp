@@ -0,0 +1,100 @@
+// From mini1
+#include "AirQualityQuery.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Narrow an optional equality predicate; two different values match nothing
+void narrowCode(std::optional<StringPool::Code> &predicate, StringPool::Code code) {
+    predicate = (!predicate || *predicate == code) ? code : StringPool::NOT_FOUND;
+}
+
+template <typename T>
+void narrowRange(std::optional<std::pair<T, T>> &predicate, T low, T high) {
+    if (predicate) {
+        low = std::max(low, predicate->first);
+        high = std::min(high, predicate->second);
+    }
+    predicate = std::make_pair(low, high);
+}
+
+}
+
+AirQualityQuery &AirQualityQuery::pollutant(const std::string &pollutantType) {
+    narrowCode(pollutantCode, StringPool::global().find(pollutantType));
+    return *this;
+}
+
+AirQualityQuery &AirQualityQuery::site(const std::string &fullSiteId) {
+    narrowCode(siteCode, StringPool::global().find(fullSiteId));
+    return *this;
+}
+
+AirQualityQuery &AirQualityQuery::timeRange(std::int64_t start, std::int64_t end) {
+    narrowRange(time, start, end);
+    return *this;
+}
+
+AirQualityQuery &AirQualityQuery::aqiRange(int minAQI, int maxAQI) {
+    narrowRange(aqi, minAQI, maxAQI);
+    return *this;
+}
+
+AirQualityQuery &AirQualityQuery::aqiAbove(int threshold) {
+    if (threshold == std::numeric_limits<int>::max()) {
+        return aqiRange(1, 0);
+    }
+    return aqiRange(threshold + 1, std::numeric_limits<int>::max());
+}
+
+AirQualityQuery &AirQualityQuery::category(int minCategory, int maxCategory) {
+    narrowRange(categories, minCategory, maxCategory);
+    return *this;
+}
+
+AirQualityQuery &AirQualityQuery::boundingBox(double south, double north, double west, double east) {
+    if (box) {
+        south = std::max(south, box->south);
+        north = std::min(north, box->north);
+        west = std::max(west, box->west);
+        east = std::min(east, box->east);
+    }
+    box = BoundingBox{south, north, west, east};
+    return *this;
+}
+
+bool AirQualityQuery::matches(const AirQualityReading &reading) const {
+    if (pollutantCode && reading.getPollutantTypeCode() != *pollutantCode) return false;
+    if (siteCode && reading.getFullSiteIdCode() != *siteCode) return false;
+    if (time && (reading.getTimestamp() < time->first || reading.getTimestamp() >= time->second)) return false;
+    if (aqi && (reading.getAirQualityIndex() < aqi->first || reading.getAirQualityIndex() > aqi->second)) return false;
+    if (categories && (reading.getCategory() < categories->first || reading.getCategory() > categories->second)) return false;
+    if (box && !box->contains(reading.getLatitude(), reading.getLongitude())) return false;
+    return true;
+}
+
+bool AirQualityQuery::mayMatch(const ZoneMaps::Zone &zone) const {
+    if (pollutantCode) {
+        bool present = false;
+        for (const auto &entry : zone.maxValueByPollutant) {
+            present = present || entry.first == *pollutantCode;
+        }
+        if (!present) return false;
+    }
+    if (time && !zone.mayContainTime(time->first, time->second)) return false;
+    if (aqi && !zone.mayContainAQI(aqi->first, aqi->second)) return false;
+    if (categories && !zone.mayContainCategory(categories->first, categories->second)) return false;
+    if (box && !zone.mayContainPoint(box->south, box->north, box->west, box->east)) return false;
+    return true;
+}
+
+const char *QueryPlan::accessName(Access access) {
+    switch (access) {
+        case Access::PollutantIndex: return "pollutant index";
+        case Access::TimeIndex: return "time index";
+        case Access::AQIIndex: return "AQI index";
+        case Access::SpatialIndex: return "spatial index";
+        default: return "zone-pruned scan";
+    }
+}
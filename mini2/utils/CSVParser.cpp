@@ -1,7 +1,11 @@
 // From mini1
 #include "CSVParser.hpp"
+#include "CSVTokenizer.hpp"
 #include <algorithm>
+#include <iterator>
 #include <cctype>
+#include <charconv>
+#include <cstdlib>
 
 // Remove leading and trailing quotes
 std::string CSVParser::removeQuotes(const std::string &str) {
@@ -11,8 +15,54 @@ std::string CSVParser::removeQuotes(const std::string &str) {
     return str;
 }
 
+// Field boundaries for one line, reused across calls on the same thread
+static std::vector<size_t> &lineFieldEnds() {
+    thread_local std::vector<size_t> fieldEnds;
+    fieldEnds.clear();
+    return fieldEnds;
+}
+
 // Parse a CSV line with proper quote handling
 std::vector<std::string> CSVParser::parseLine(const std::string &line) {
+    std::vector<size_t> &fieldEnds = lineFieldEnds();
+    
+    // An embedded newline would end the tokenizer's record early
+    if (CSVTokenizer::scanRecord(line, 0, fieldEnds) != line.length()) {
+        return parseLineScalar(line);
+    }
+    
+    std::vector<std::string> fields;
+    fields.reserve(fieldEnds.size());
+    
+    size_t fieldStart = 0;
+    for (size_t fieldEnd : fieldEnds) {
+        const char *begin = line.data() + fieldStart;
+        const char *end = line.data() + fieldEnd;
+        
+        // Common case: no quotes, or just one enclosing pair
+        const char *innerBegin = begin;
+        const char *innerEnd = end;
+        if (end - begin >= 2 && *begin == '"' && *(end - 1) == '"') {
+            innerBegin++;
+            innerEnd--;
+        }
+        
+        if (std::find(innerBegin, innerEnd, '"') == innerEnd) {
+            fields.emplace_back(innerBegin, innerEnd);
+        } else {
+            // Quote characters only switch state; they are never part of a field
+            std::string field;
+            std::copy_if(begin, end, std::back_inserter(field), [](char c) { return c != '"'; });
+            fields.push_back(std::move(field));
+        }
+        fieldStart = fieldEnd + 1;
+    }
+    
+    return fields;
+}
+
+// Reference implementation: one character at a time
+std::vector<std::string> CSVParser::parseLineScalar(const std::string &line) {
     std::vector<std::string> fields;
     std::string field;
     bool inQuotes = false;
@@ -37,8 +87,176 @@ std::vector<std::string> CSVParser::parseLine(const std::string &line) {
     return fields;
 }
 
+// Strip one pair of enclosing quotes from a field view
+static std::string_view unquoteView(std::string_view field, bool &clean) {
+    if (field.length() >= 2 && field.front() == '"' && field.back() == '"') {
+        field = field.substr(1, field.length() - 2);
+    }
+    // Any quote left over would be dropped by parseLine, which a view cannot do
+    if (field.find('"') != std::string_view::npos) {
+        clean = false;
+    }
+    return field;
+}
+
+// Parse a CSV line into views with the same quote handling as parseLine
+bool CSVParser::parseLineView(std::string_view line, std::vector<std::string_view> &fields) {
+    fields.clear();
+    std::vector<size_t> &fieldEnds = lineFieldEnds();
+    
+    if (CSVTokenizer::scanRecord(line, 0, fieldEnds) != line.length()) {
+        return false;
+    }
+    
+    bool clean = true;
+    size_t fieldStart = 0;
+    for (size_t fieldEnd : fieldEnds) {
+        fields.push_back(unquoteView(line.substr(fieldStart, fieldEnd - fieldStart), clean));
+        fieldStart = fieldEnd + 1;
+    }
+    
+    return clean;
+}
+
+// Views over the line, falling back to copies for fields with inner quotes
+void CSVParser::splitLine(std::string_view line, std::vector<std::string_view> &fields,
+                          std::vector<std::string> &storage) {
+    if (parseLineView(line, fields)) {
+        return;
+    }
+    storage = parseLine(std::string(line));
+    fields.assign(storage.begin(), storage.end());
+}
+
+// Slice the next line out of a buffer
+std::string_view CSVParser::nextLine(std::string_view buffer, size_t &pos) {
+    size_t end = buffer.find('\n', pos);
+    if (end == std::string_view::npos) {
+        end = buffer.length();
+    }
+    
+    std::string_view line = buffer.substr(pos, end - pos);
+    pos = end + 1;
+    return line;
+}
+
+std::vector<std::pair<size_t, size_t>> CSVParser::splitLineRanges(std::string_view buffer,
+                                                                  size_t targetBytes) {
+    std::vector<std::pair<size_t, size_t>> ranges;
+    if (targetBytes == 0) {
+        targetBytes = 1;
+    }
+    
+    size_t begin = 0;
+    while (begin < buffer.length()) {
+        size_t end = buffer.length();
+        
+        // Push the cut forward to the next newline so no line is split
+        if (buffer.length() - begin > targetBytes) {
+            size_t newline = buffer.find('\n', begin + targetBytes - 1);
+            if (newline != std::string_view::npos) {
+                end = newline + 1;
+            }
+        }
+        
+        ranges.emplace_back(begin, end);
+        begin = end;
+    }
+    
+    return ranges;
+}
+
+bool CSVParser::parseDouble(std::string_view str, double &value) {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto result = std::from_chars(str.data(), str.data() + str.size(), value);
+    return result.ec == std::errc() && result.ptr != str.data();
+#else
+    // Standard libraries without floating-point from_chars: strtod needs a terminator
+    char buffer[64];
+    if (str.empty() || str.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::copy(str.begin(), str.end(), buffer);
+    buffer[str.size()] = '\0';
+    char *end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end != buffer;
+#endif
+}
+
+bool CSVParser::parseInt(std::string_view str, int &value) {
+    auto result = std::from_chars(str.data(), str.data() + str.size(), value);
+    return result.ec == std::errc() && result.ptr != str.data();
+}
+
+bool CSVParser::parseLong(std::string_view str, long &value) {
+    auto result = std::from_chars(str.data(), str.data() + str.size(), value);
+    return result.ec == std::errc() && result.ptr != str.data();
+}
+
+namespace {
+
+// Read exactly count digits at pos, advancing pos
+bool readDigits(std::string_view str, size_t &pos, size_t count, int &value) {
+    if (str.size() - pos < count) return false;
+    
+    value = 0;
+    for (size_t end = pos + count; pos < end; pos++) {
+        if (str[pos] < '0' || str[pos] > '9') return false;
+        value = value * 10 + (str[pos] - '0');
+    }
+    return true;
+}
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's algorithm)
+std::int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+}
+
+}
+
+bool CSVParser::parseEpochSeconds(std::string_view str, std::int64_t &seconds) {
+    size_t pos = 0;
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    
+    if (!readDigits(str, pos, 4, year) || pos >= str.size() || str[pos++] != '-' ||
+        !readDigits(str, pos, 2, month) || pos >= str.size() || str[pos++] != '-' ||
+        !readDigits(str, pos, 2, day)) {
+        return false;
+    }
+    
+    if (pos < str.size() && (str[pos] == 'T' || str[pos] == ' ')) {
+        pos++;
+        if (!readDigits(str, pos, 2, hour) || pos >= str.size() || str[pos++] != ':' ||
+            !readDigits(str, pos, 2, minute)) {
+            return false;
+        }
+        if (pos < str.size() && str[pos] == ':') {
+            pos++;
+            if (!readDigits(str, pos, 2, second)) return false;
+        }
+    }
+    
+    if (pos < str.size() && str[pos] == 'Z') {
+        pos++;
+    }
+    
+    if (pos != str.size() || month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+    
+    seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return true;
+}
+
 // Check if line is empty or whitespace
-bool CSVParser::isEmpty(const std::string &line) {
+bool CSVParser::isEmpty(std::string_view line) {
     return line.empty() || 
            std::all_of(line.begin(), line.end(), 
                       [](unsigned char c) { return std::isspace(c); });
@@ -52,4 +270,15 @@ std::string CSVParser::trim(const std::string &str) {
                                 [](unsigned char c) { return std::isspace(c); }).base();
     
     return (start < end) ? std::string(start, end) : std::string();
-}
\ No newline at end of file
+}
+
+// Trim whitespace from both ends without copying
+std::string_view CSVParser::trimView(std::string_view str) {
+    size_t start = 0;
+    size_t end = str.length();
+    
+    while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) start++;
+    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) end--;
+    
+    return str.substr(start, end - start);
+}
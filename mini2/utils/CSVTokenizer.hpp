@@ -0,0 +1,46 @@
+// From mini1
+#ifndef CSV_TOKENIZER_HPP
+#define CSV_TOKENIZER_HPP
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * CSVTokenizer - Block-at-a-time search for CSV structure
+ *
+ * Classifies 64 bytes at a time into comma / quote / newline bitmasks
+ * (AVX2 or SSE2 on x86, plain C++ elsewhere) and turns them into field
+ * offsets. Quote handling matches CSVParser::parseLine exactly: every '"'
+ * toggles the quoted state, and only commas outside quotes end a field.
+ * A newline always ends the record, like std::getline.
+ */
+class CSVTokenizer {
+public:
+    enum class Kernel {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+    
+    // Fastest kernel the running CPU supports (detected once)
+    static Kernel bestKernel();
+    
+    static const char *kernelName(Kernel kernel);
+    
+    /**
+     * Scan one record of buffer starting at pos.
+     *
+     * Appends to fieldEnds the offset of every unquoted ',' in the record,
+     * followed by the offset where the record ends. Field i therefore spans
+     * [previous end + 1, fieldEnds[i]), the first one starting at pos.
+     *
+     * @return Offset of the record's '\n', or buffer.size() if there is none
+     */
+    static size_t scanRecord(std::string_view buffer, size_t pos,
+                             std::vector<size_t> &fieldEnds);
+    static size_t scanRecord(std::string_view buffer, size_t pos,
+                             std::vector<size_t> &fieldEnds, Kernel kernel);
+};
+
+#endif // CSV_TOKENIZER_HPP
@@ -0,0 +1,45 @@
+// From mini1
+#ifndef DIRECTORY_WATCHER_HPP
+#define DIRECTORY_WATCHER_HPP
+
+#include <map>
+#include <string>
+
+/**
+ * DirectoryWatcher - Wait for files to appear under a root of date folders
+ *
+ * On Linux this is an inotify watch on the root and on every folder below
+ * it (folders created later are watched as they appear). If the kernel's
+ * event queue overflows, that counts as a change and every folder is
+ * watched again, since the lost events cannot be recovered. Only finished
+ * files count as changes: a file closed after writing or moved into place,
+ * never one that is still being written. Elsewhere it falls back to
+ * sleeping for the timeout and reporting a change, so callers simply
+ * rescan. The watch is released when the object is destroyed.
+ */
+class DirectoryWatcher {
+private:
+    int fd;
+    std::map<int, std::string> watchedFolders;  // watch descriptor -> path
+    std::string rootPath;
+
+public:
+    explicit DirectoryWatcher(const std::string &rootPath);
+    ~DirectoryWatcher();
+
+    DirectoryWatcher(const DirectoryWatcher &) = delete;
+    DirectoryWatcher &operator=(const DirectoryWatcher &) = delete;
+
+    // False if the root could not be watched (polling is still possible)
+    bool isOpen() const { return fd >= 0; }
+
+    // Block for up to timeoutMillis; true if a file or folder appeared or
+    // was rewritten under the root since the last call
+    bool waitForChange(int timeoutMillis);
+
+private:
+    void watchFolder(const std::string &path, bool isRoot);
+    void watchDateFolders();
+};
+
+#endif // DIRECTORY_WATCHER_HPP
@@ -0,0 +1,70 @@
+// From mini1
+#include "MappedFile.hpp"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &filename)
+    : data(nullptr), length(0), opened(false) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return;
+    }
+    
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0) {
+        void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return;
+        }
+        // Loaders read front to back, so let the kernel read ahead aggressively
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+        data = static_cast<const char *>(mapping);
+    }
+    
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    opened = true;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data(other.data), length(other.length), opened(other.opened) {
+    other.data = nullptr;
+    other.length = 0;
+    other.opened = false;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        unmap();
+        data = other.data;
+        length = other.length;
+        opened = other.opened;
+        other.data = nullptr;
+        other.length = 0;
+        other.opened = false;
+    }
+    return *this;
+}
+
+void MappedFile::unmap() {
+    if (data != nullptr) {
+        ::munmap(const_cast<char *>(data), length);
+    }
+    data = nullptr;
+    length = 0;
+    opened = false;
+}
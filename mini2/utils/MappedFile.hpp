@@ -0,0 +1,43 @@
+// From mini1
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * MappedFile - Read-only memory mapping of a whole file (RAII)
+ *
+ * The file's bytes are exposed as a string_view, so parsers can hand out
+ * views into the mapping instead of copying lines and fields. The mapping
+ * is released when the object is destroyed; views must not outlive it.
+ */
+class MappedFile {
+private:
+    const char *data;
+    size_t length;
+    bool opened;
+
+public:
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    
+    // True if the file was opened (an empty file is open with size 0)
+    bool isOpen() const { return opened; }
+    
+    size_t size() const { return length; }
+    
+    std::string_view view() const { return std::string_view(data, length); }
+
+private:
+    void unmap();
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,178 @@
+// From mini1
+#include "RollupCube.hpp"
+#include "TimeIndex.hpp"
+#include <algorithm>
+
+namespace {
+
+// Floor division, so instants before 1970 land in the right bucket
+std::int64_t floorTo(std::int64_t timestamp, std::int64_t width) {
+    std::int64_t start = timestamp / width * width;
+    return start > timestamp ? start - width : start;
+}
+
+// Put saved cells back; a saved count of 0 means the cell did not exist
+template <typename Cells, typename Saved>
+void restoreCells(Cells &cells, const Saved &saved) {
+    for (const auto &pair : saved) {
+        if (pair.second.count == 0) {
+            cells.erase(pair.first);
+        } else {
+            cells[pair.first] = pair.second;
+        }
+    }
+}
+
+// Same for per-pollutant time series, keyed by (pollutant, start)
+template <typename Series, typename Saved>
+void restoreSeries(Series &series, const Saved &saved) {
+    for (const auto &pair : saved) {
+        auto &byStart = series[pair.first.first];
+        if (pair.second.count == 0) {
+            byStart.erase(pair.first.second);
+        } else {
+            byStart[pair.first.second] = pair.second;
+        }
+        if (byStart.empty()) {
+            series.erase(pair.first.first);
+        }
+    }
+}
+
+}
+
+void RollupCube::Stats::add(double value) {
+    if (count == 0) {
+        min = value;
+        max = value;
+    } else {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    count++;
+    sum += value;
+    sumSquares += value * value;
+}
+
+void RollupCube::Stats::merge(const Stats &other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    count += other.count;
+    sum += other.sum;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sumSquares += other.sumSquares;
+}
+
+double RollupCube::Stats::variance() const {
+    if (count == 0) return 0.0;
+    double mean = sum / count;
+    // Clamp the rounding error of E[x^2] - E[x]^2 for near-constant values
+    return std::max(0.0, sumSquares / count - mean * mean);
+}
+
+void RollupCube::add(const Entry &entry, bool saveCells) {
+    // emplace() keeps the first saved state of a cell
+    Stats &total = totals[entry.pollutant];
+    Stats &site = sites[{entry.pollutant, entry.site}];
+    if (saveCells) {
+        undo.totals.emplace(entry.pollutant, total);
+        undo.sites.emplace(std::make_pair(entry.pollutant, entry.site), site);
+    }
+    total.add(entry.value);
+    site.add(entry.value);
+
+    if (entry.timestamp == AirQualityReading::NO_TIMESTAMP) return;
+
+    HourKey hourKey{entry.pollutant, entry.site, floorTo(entry.timestamp, TimeIndex::HOUR)};
+    std::int64_t dayStart = floorTo(entry.timestamp, TimeIndex::DAY);
+    std::int64_t month = monthStart(entry.timestamp);
+    Stats &hour = hours[hourKey];
+    Stats &day = daily[entry.pollutant][dayStart];
+    Stats &monthStats = monthly[entry.pollutant][month];
+    if (saveCells) {
+        undo.hours.emplace(hourKey, hour);
+        undo.daily.emplace(std::make_pair(entry.pollutant, dayStart), day);
+        undo.monthly.emplace(std::make_pair(entry.pollutant, month), monthStats);
+    }
+    hour.add(entry.value);
+    day.add(entry.value);
+    monthStats.add(entry.value);
+}
+
+void RollupCube::checkpoint(size_t rowCount) {
+    undo = Undo();
+    checkpointRow = rowCount >= foldedRows ? rowCount : NO_CHECKPOINT;
+}
+
+bool RollupCube::truncate(size_t rowCount) {
+    if (rowCount >= foldedRows) return true;
+    if (rowCount != checkpointRow) return false;
+
+    restoreCells(hours, undo.hours);
+    restoreCells(totals, undo.totals);
+    restoreCells(sites, undo.sites);
+    restoreSeries(daily, undo.daily);
+    restoreSeries(monthly, undo.monthly);
+
+    undo = Undo();
+    foldedRows = rowCount;
+    return true;
+}
+
+void RollupCube::clear() {
+    hours.clear();
+    totals.clear();
+    sites.clear();
+    daily.clear();
+    monthly.clear();
+    foldedRows = 0;
+    undo = Undo();
+    checkpointRow = NO_CHECKPOINT;
+}
+
+RollupCube::Stats RollupCube::getTotal(StringPool::Code pollutant) const {
+    auto it = totals.find(pollutant);
+    return it != totals.end() ? it->second : Stats();
+}
+
+RollupCube::Stats RollupCube::getSite(StringPool::Code pollutant, StringPool::Code site) const {
+    auto it = sites.find({pollutant, site});
+    return it != sites.end() ? it->second : Stats();
+}
+
+RollupCube::Stats RollupCube::getHour(StringPool::Code pollutant, StringPool::Code site, std::int64_t hourStart) const {
+    auto it = hours.find({pollutant, site, hourStart});
+    return it != hours.end() ? it->second : Stats();
+}
+
+const std::map<std::int64_t, RollupCube::Stats> &RollupCube::getDaily(StringPool::Code pollutant) const {
+    static const std::map<std::int64_t, Stats> empty;
+    auto it = daily.find(pollutant);
+    return it != daily.end() ? it->second : empty;
+}
+
+const std::map<std::int64_t, RollupCube::Stats> &RollupCube::getMonthly(StringPool::Code pollutant) const {
+    static const std::map<std::int64_t, Stats> empty;
+    auto it = monthly.find(pollutant);
+    return it != monthly.end() ? it->second : empty;
+}
+
+// Start of the calendar month holding timestamp: the day of month comes
+// from H. Hinnant's civil-from-days algorithm, then step back to the 1st
+std::int64_t RollupCube::monthStart(std::int64_t timestamp) {
+    std::int64_t days = floorTo(timestamp, TimeIndex::DAY) / TimeIndex::DAY;
+
+    std::int64_t shifted = days + 719468;
+    const std::int64_t era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(shifted - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+    const unsigned dayOfMonth = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+
+    return (days - (dayOfMonth - 1)) * TimeIndex::DAY;
+}
@@ -0,0 +1,73 @@
+// From mini1
+#include "StreamingAggregation.hpp"
+#include "AirQualityCSVLoader.hpp"
+#include <omp.h>
+
+std::unique_ptr<StreamAggregator> PollutantValueAggregator::emptyCopy() const {
+    return std::make_unique<PollutantValueAggregator>();
+}
+
+void PollutantValueAggregator::add(const AirQualityReading &reading) {
+    stats[reading.getPollutantTypeCode()].add(reading.getValue());
+}
+
+void PollutantValueAggregator::merge(const StreamAggregator &other) {
+    for (const auto &entry : static_cast<const PollutantValueAggregator &>(other).stats) {
+        stats[entry.first].merge(entry.second);
+    }
+}
+
+RollupCube::Stats PollutantValueAggregator::getStats(const std::string &pollutantType) const {
+    auto it = stats.find(StringPool::global().find(pollutantType));
+    return it != stats.end() ? it->second : RollupCube::Stats();
+}
+
+std::unique_ptr<StreamAggregator> AQIAboveCounter::emptyCopy() const {
+    return std::make_unique<AQIAboveCounter>(threshold);
+}
+
+void AQIAboveCounter::add(const AirQualityReading &reading) {
+    count += reading.getAirQualityIndex() > threshold;
+}
+
+void AQIAboveCounter::merge(const StreamAggregator &other) {
+    count += static_cast<const AQIAboveCounter &>(other).count;
+}
+
+void StreamingAggregation::addAggregator(StreamAggregator &aggregator) {
+    aggregators.push_back(&aggregator);
+}
+
+size_t StreamingAggregation::run(const std::string &rootPath, int numThreads) {
+    return runFiles(AirQualityCSVLoader::listCSVFiles(rootPath), numThreads);
+}
+
+size_t StreamingAggregation::runFiles(const std::vector<std::string> &filenames, int numThreads) {
+    size_t readingsSeen = 0;
+
+    #pragma omp parallel num_threads(numThreads) reduction(+:readingsSeen)
+    {
+        std::vector<std::unique_ptr<StreamAggregator>> local;
+        for (const StreamAggregator *aggregator : aggregators) {
+            local.push_back(aggregator->emptyCopy());
+        }
+
+        // Hourly files differ a lot in size, so hand them out one at a time
+        #pragma omp for schedule(dynamic)
+        for (size_t i = 0; i < filenames.size(); i++) {
+            readingsSeen += AirQualityCSVLoader::loadFromCSV(filenames[i], [&local](const AirQualityReading &reading) {
+                for (auto &aggregator : local) {
+                    aggregator->add(reading);
+                }
+            }, CSVReadMode::MemoryMapped);
+        }
+
+        // One thread at a time folds its partial states in
+        #pragma omp critical
+        for (size_t a = 0; a < aggregators.size(); a++) {
+            aggregators[a]->merge(*local[a]);
+        }
+    }
+
+    return readingsSeen;
+}
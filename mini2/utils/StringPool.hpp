@@ -0,0 +1,70 @@
+// From mini1
+#ifndef STRING_POOL_HPP
+#define STRING_POOL_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * StringPool - Dictionary of interned strings
+ *
+ * Every distinct string is stored once and identified by a compact integer
+ * code, so low-cardinality columns (pollutant, unit, site, agency...) carry
+ * 4-byte codes instead of their own heap copies and equality filters become
+ * integer comparisons. Codes are never reused or invalidated, and references
+ * returned by get() stay valid for the lifetime of the pool.
+ *
+ * All operations are thread-safe. intern() and find() of an existing string
+ * only take a shared lock, so parallel loaders rarely contend; get() takes
+ * no lock at all, as strings live in chunks that are never moved or freed
+ * while the pool exists, so per-row string getters in hot loops do not
+ * bounce a lock's cache line between threads.
+ */
+class StringPool {
+public:
+    using Code = std::uint32_t;
+    
+    static constexpr Code NOT_FOUND = UINT32_MAX;
+    
+    // Process-wide pool shared by every data manager
+    static StringPool &global();
+    
+    // Return the code for str, adding it to the pool if needed
+    Code intern(std::string_view str);
+    
+    // Return the code for str, or NOT_FOUND if it was never interned
+    Code find(std::string_view str) const;
+    
+    // Decode a code back to its string (lock-free; code must have been returned by this pool)
+    const std::string &get(Code code) const {
+        size_t index = static_cast<size_t>(code) + FIRST_CHUNK_SIZE;
+        unsigned chunk = 63 - static_cast<unsigned>(__builtin_clzll(index)) - FIRST_CHUNK_BITS;
+        return chunks[chunk].load(std::memory_order_acquire)[index - (FIRST_CHUNK_SIZE << chunk)];
+    }
+    
+    // Number of distinct strings in the pool
+    size_t size() const;
+
+    StringPool() = default;
+    ~StringPool();
+
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+
+private:
+    // Chunk k holds FIRST_CHUNK_SIZE << k strings, so 32 chunks cover every code
+    static constexpr unsigned FIRST_CHUNK_BITS = 6;
+    static constexpr size_t FIRST_CHUNK_SIZE = size_t(1) << FIRST_CHUNK_BITS;
+    static constexpr unsigned MAX_CHUNKS = 32;
+
+    mutable std::shared_mutex mutex;                     // guards codes and count
+    std::atomic<std::string *> chunks[MAX_CHUNKS] = {};
+    size_t count = 0;
+    std::unordered_map<std::string_view, Code> codes;    // views point into chunks
+};
+
+#endif // STRING_POOL_HPP
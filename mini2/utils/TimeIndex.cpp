@@ -0,0 +1,112 @@
+// From mini1
+#include "TimeIndex.hpp"
+#include <algorithm>
+
+void TimeIndex::append(std::vector<std::pair<std::int64_t, RowId>> entries) {
+    if (entries.empty()) return;
+
+    // Files are usually one hour each, so this is close to a linear pass
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<std::int64_t> mergedTimestamps;
+    std::vector<RowId> mergedRowIds;
+    mergedTimestamps.reserve(timestamps.size() + entries.size());
+    mergedRowIds.reserve(rowIds.size() + entries.size());
+
+    // New row ids are larger than existing ones, so on equal timestamps the
+    // existing entry goes first and (timestamp, row id) order is preserved
+    size_t i = 0;
+    for (const auto &entry : entries) {
+        for (; i < timestamps.size() && timestamps[i] <= entry.first; i++) {
+            mergedTimestamps.push_back(timestamps[i]);
+            mergedRowIds.push_back(rowIds[i]);
+        }
+        mergedTimestamps.push_back(entry.first);
+        mergedRowIds.push_back(entry.second);
+    }
+    mergedTimestamps.insert(mergedTimestamps.end(), timestamps.begin() + i, timestamps.end());
+    mergedRowIds.insert(mergedRowIds.end(), rowIds.begin() + i, rowIds.end());
+
+    timestamps.swap(mergedTimestamps);
+    rowIds.swap(mergedRowIds);
+
+    rebuildBuckets(hourBuckets, HOUR);
+    rebuildBuckets(dayBuckets, DAY);
+}
+
+bool TimeIndex::assign(std::vector<std::int64_t> sortedTimestamps, std::vector<RowId> sortedRowIds) {
+    clear();
+
+    if (sortedTimestamps.size() != sortedRowIds.size()) return false;
+    for (size_t pos = 1; pos < sortedTimestamps.size(); pos++) {
+        if (sortedTimestamps[pos - 1] > sortedTimestamps[pos] ||
+            (sortedTimestamps[pos - 1] == sortedTimestamps[pos] && sortedRowIds[pos - 1] >= sortedRowIds[pos])) {
+            return false;
+        }
+    }
+
+    timestamps.swap(sortedTimestamps);
+    rowIds.swap(sortedRowIds);
+
+    rebuildBuckets(hourBuckets, HOUR);
+    rebuildBuckets(dayBuckets, DAY);
+    return true;
+}
+
+void TimeIndex::truncate(RowId rowCount) {
+    size_t kept = 0;
+    for (size_t pos = 0; pos < rowIds.size(); pos++) {
+        if (rowIds[pos] < rowCount) {
+            timestamps[kept] = timestamps[pos];
+            rowIds[kept] = rowIds[pos];
+            kept++;
+        }
+    }
+    if (kept == rowIds.size()) return;
+
+    timestamps.resize(kept);
+    rowIds.resize(kept);
+
+    rebuildBuckets(hourBuckets, HOUR);
+    rebuildBuckets(dayBuckets, DAY);
+}
+
+void TimeIndex::clear() {
+    timestamps.clear();
+    rowIds.clear();
+    hourBuckets.clear();
+    dayBuckets.clear();
+}
+
+std::pair<size_t, size_t> TimeIndex::find(std::int64_t start, std::int64_t end) const {
+    if (end <= start) return {0, 0};
+
+    auto first = std::lower_bound(timestamps.begin(), timestamps.end(), start);
+    auto last = std::lower_bound(first, timestamps.end(), end);
+
+    return {static_cast<size_t>(first - timestamps.begin()),
+            static_cast<size_t>(last - timestamps.begin())};
+}
+
+void TimeIndex::rebuildBuckets(std::vector<Bucket> &buckets, std::int64_t width) const {
+    buckets.clear();
+
+    for (size_t pos = 0; pos < timestamps.size(); pos++) {
+        // Floor division, so instants before 1970 land in the right bucket
+        std::int64_t start = timestamps[pos] / width * width;
+        if (start > timestamps[pos]) {
+            start -= width;
+        }
+
+        if (buckets.empty() || buckets.back().start != start) {
+            if (!buckets.empty()) {
+                buckets.back().end = pos;
+            }
+            buckets.push_back({start, pos, pos});
+        }
+    }
+
+    if (!buckets.empty()) {
+        buckets.back().end = timestamps.size();
+    }
+}